@@ -83,7 +83,13 @@ enum sbar_field_t : unsigned long long {
     sbar_field_username = sbar_field_audio_capture_volume << 1,
     sbar_field_kernel = sbar_field_username << 1,
     sbar_field_outdated_kernel = sbar_field_kernel << 1,
-    sbar_field_all = (sbar_field_outdated_kernel << 1) - 1ULL,
+    sbar_field_context_switches = sbar_field_outdated_kernel << 1,
+    sbar_field_interrupts = sbar_field_context_switches << 1,
+    sbar_field_procs_running = sbar_field_interrupts << 1,
+    sbar_field_memory_available = sbar_field_procs_running << 1,
+    sbar_field_memory_cached = sbar_field_memory_available << 1,
+    sbar_field_memory_dirty = sbar_field_memory_cached << 1,
+    sbar_field_all = (sbar_field_memory_dirty << 1) - 1ULL,
 };
 typedef enum sbar_field_t sbar_field_t;
 
@@ -132,6 +138,12 @@ enum sbar_top_field_t : unsigned long long {
     sbar_top_field_username = sbar_field_username,
     sbar_top_field_kernel = sbar_field_kernel,
     sbar_top_field_outdated_kernel = sbar_field_outdated_kernel,
+    sbar_top_field_context_switches = sbar_field_context_switches,
+    sbar_top_field_interrupts = sbar_field_interrupts,
+    sbar_top_field_procs_running = sbar_field_procs_running,
+    sbar_top_field_memory_available = sbar_field_memory_available,
+    sbar_top_field_memory_cached = sbar_field_memory_cached,
+    sbar_top_field_memory_dirty = sbar_field_memory_dirty,
     sbar_top_field_all = sbar_field_all,
 };
 typedef enum sbar_top_field_t sbar_top_field_t;
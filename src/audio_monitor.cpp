@@ -0,0 +1,278 @@
+// Standard includes
+#include <string>
+#include <utility>
+
+// External includes
+#include <alsa/asoundlib.h>
+
+// Local includes
+#include "audio_monitor.hpp"
+
+namespace sbar {
+
+namespace {
+
+int element_callback(snd_mixer_elem_t* elem, unsigned int mask) {
+    auto* changed_fields = static_cast<unsigned long long*>(
+      snd_mixer_elem_get_callback_private(elem));
+
+    if (mask == SND_CTL_EVENT_MASK_REMOVE) {
+        *changed_fields |= sbar_field_audio_playback | sbar_field_audio_capture;
+        return 0;
+    }
+
+    if (snd_mixer_selem_has_playback_volume(elem) != 0
+      || snd_mixer_selem_has_playback_switch(elem) != 0) {
+        *changed_fields |= sbar_field_audio_playback;
+    }
+    if (snd_mixer_selem_has_capture_volume(elem) != 0
+      || snd_mixer_selem_has_capture_switch(elem) != 0) {
+        *changed_fields |= sbar_field_audio_capture;
+    }
+
+    return 0;
+}
+
+int mixer_callback(
+  snd_mixer_t* mixer, unsigned int mask, snd_mixer_elem_t* elem) {
+    if ((mask & SND_CTL_EVENT_MASK_ADD) == 0) {
+        return 0;
+    }
+
+    auto* changed_fields = snd_mixer_get_callback_private(mixer);
+    snd_mixer_elem_set_callback(elem, element_callback);
+    snd_mixer_elem_set_callback_private(elem, changed_fields);
+
+    *static_cast<unsigned long long*>(changed_fields) |=
+      sbar_field_audio_playback | sbar_field_audio_capture;
+
+    return 0;
+}
+
+/**
+ * @brief The ALSA functions that read one direction (playback or capture) of
+ * a simple mixer control.
+ */
+struct direction_t {
+    int (*has_switch)(snd_mixer_elem_t*);
+    int (*has_volume)(snd_mixer_elem_t*);
+    int (*has_channel)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t);
+    int (*get_switch)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, int*);
+    int (*get_volume)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, long*);
+    int (*get_volume_range)(snd_mixer_elem_t*, long*, long*);
+};
+
+const direction_t playback{
+    snd_mixer_selem_has_playback_switch,
+    snd_mixer_selem_has_playback_volume,
+    snd_mixer_selem_has_playback_channel,
+    snd_mixer_selem_get_playback_switch,
+    snd_mixer_selem_get_playback_volume,
+    snd_mixer_selem_get_playback_volume_range,
+};
+
+const direction_t capture{
+    snd_mixer_selem_has_capture_switch,
+    snd_mixer_selem_has_capture_volume,
+    snd_mixer_selem_has_capture_channel,
+    snd_mixer_selem_get_capture_switch,
+    snd_mixer_selem_get_capture_volume,
+    snd_mixer_selem_get_capture_volume_range,
+};
+
+/**
+ * @brief Read a value for each channel of a control.
+ *
+ * @param[in] read - Returns the value of a channel or std::nullopt if the
+ * channel is missing.
+ */
+template<typename value_t, typename read_t>
+audio_monitor_t::channels_t<value_t> read_channels(read_t read) {
+    audio_monitor_t::channels_t<value_t> channels;
+
+    channels.front_left = read(SND_MIXER_SCHN_FRONT_LEFT);
+    channels.front_center = read(SND_MIXER_SCHN_FRONT_CENTER);
+    channels.front_right = read(SND_MIXER_SCHN_FRONT_RIGHT);
+    channels.side_left = read(SND_MIXER_SCHN_SIDE_LEFT);
+    channels.woofer = read(SND_MIXER_SCHN_WOOFER);
+    channels.side_right = read(SND_MIXER_SCHN_SIDE_RIGHT);
+    channels.rear_left = read(SND_MIXER_SCHN_REAR_LEFT);
+    channels.rear_center = read(SND_MIXER_SCHN_REAR_CENTER);
+    channels.rear_right = read(SND_MIXER_SCHN_REAR_RIGHT);
+
+    return channels;
+}
+
+/**
+ * @brief Read the switch and volume of one direction of a control.
+ *
+ * @param[in] elem - The simple mixer control.
+ * @param[in] direction - Playback or capture.
+ * @param[out] status - Whether each channel is unmuted.
+ * @param[out] volume - The volume of each channel in percent.
+ */
+void read_direction(snd_mixer_elem_t* elem,
+  const direction_t& direction,
+  std::optional<audio_monitor_t::channels_t<bool>>& status,
+  std::optional<audio_monitor_t::channels_t<double>>& volume) {
+    if (direction.has_switch(elem) != 0) {
+        status = read_channels<bool>(
+          [&](snd_mixer_selem_channel_id_t channel) -> std::optional<bool> {
+              int value = 0;
+              if (direction.has_channel(elem, channel) == 0
+                || direction.get_switch(elem, channel, &value) < 0) {
+                  return std::nullopt;
+              }
+              return value != 0;
+          });
+    }
+
+    long min = 0;
+    long max = 0;
+    if (direction.has_volume(elem) == 0
+      || direction.get_volume_range(elem, &min, &max) < 0 || max <= min) {
+        return;
+    }
+
+    volume = read_channels<double>(
+      [&](snd_mixer_selem_channel_id_t channel) -> std::optional<double> {
+          long value = 0;
+          if (direction.has_channel(elem, channel) == 0
+            || direction.get_volume(elem, channel, &value) < 0) {
+              return std::nullopt;
+          }
+          return 100.0 * static_cast<double>(value - min)
+            / static_cast<double>(max - min);
+      });
+}
+
+res::error_t alsa_error(const std::string& message, int error) {
+    return RES_NEW_ERROR(message + "\n\terror: " + snd_strerror(error));
+}
+
+} // namespace
+
+res::optional_t<audio_monitor_t> get_audio_monitor() {
+    snd_mixer_t* mixer = nullptr;
+
+    int error = snd_mixer_open(&mixer, 0);
+    if (error < 0) {
+        return alsa_error("Failed to open the ALSA mixer.", error);
+    }
+
+    audio_monitor_t audio_monitor{ mixer };
+
+    snd_mixer_set_callback(mixer, mixer_callback);
+    snd_mixer_set_callback_private(
+      mixer, audio_monitor.changed_fields_.get());
+
+    error = snd_mixer_attach(mixer, "default");
+    if (error < 0) {
+        return alsa_error("Failed to attach the default sound card to the "
+                          "ALSA mixer.",
+          error);
+    }
+
+    error = snd_mixer_selem_register(mixer, nullptr, nullptr);
+    if (error < 0) {
+        return alsa_error(
+          "Failed to register the ALSA simple element class.", error);
+    }
+
+    error = snd_mixer_load(mixer);
+    if (error < 0) {
+        return alsa_error("Failed to load the ALSA mixer.", error);
+    }
+
+    audio_monitor.read_controls();
+
+    return audio_monitor;
+}
+
+audio_monitor_t::audio_monitor_t(void* mixer)
+: mixer_(mixer)
+, changed_fields_(std::make_unique<unsigned long long>(sbar_field_none))
+, mutex_(std::make_unique<std::mutex>()) {
+}
+
+audio_monitor_t::audio_monitor_t(audio_monitor_t&& audio_monitor) noexcept
+: mixer_(audio_monitor.mixer_)
+, changed_fields_(std::move(audio_monitor.changed_fields_))
+, controls_(std::move(audio_monitor.controls_))
+, mutex_(std::move(audio_monitor.mutex_)) {
+    audio_monitor.mixer_ = nullptr;
+}
+
+audio_monitor_t::~audio_monitor_t() {
+    if (this->mixer_ != nullptr) {
+        snd_mixer_close(static_cast<snd_mixer_t*>(this->mixer_));
+    }
+}
+
+void audio_monitor_t::read_controls() {
+    auto* mixer = static_cast<snd_mixer_t*>(this->mixer_);
+
+    // The mixer keeps the values reported by its events, so reading them
+    // does not talk to the sound card.
+    std::vector<control_t> controls;
+    for (snd_mixer_elem_t* elem = snd_mixer_first_elem(mixer); elem != nullptr;
+         elem = snd_mixer_elem_next(elem)) {
+        control_t control;
+        control.name = snd_mixer_selem_get_name(elem);
+        read_direction(elem,
+          playback,
+          control.playback_status,
+          control.playback_volume);
+        read_direction(
+          elem, capture, control.capture_status, control.capture_volume);
+        controls.push_back(std::move(control));
+    }
+
+    std::lock_guard lock{ *this->mutex_ };
+    this->controls_ = std::move(controls);
+}
+
+std::vector<int> audio_monitor_t::fds() const {
+    auto* mixer = static_cast<snd_mixer_t*>(this->mixer_);
+
+    int count = snd_mixer_poll_descriptors_count(mixer);
+    if (count <= 0) {
+        return {};
+    }
+
+    std::vector<pollfd> descriptors(count);
+    count = snd_mixer_poll_descriptors(
+      mixer, descriptors.data(), static_cast<unsigned int>(count));
+
+    std::vector<int> fds;
+    for (int index = 0; index < count; ++index) {
+        fds.push_back(descriptors.at(index).fd);
+    }
+
+    return fds;
+}
+
+res::optional_t<sbar_field_t> audio_monitor_t::handle_events() {
+    int error =
+      snd_mixer_handle_events(static_cast<snd_mixer_t*>(this->mixer_));
+    if (error < 0) {
+        return alsa_error("Failed to handle ALSA mixer events.", error);
+    }
+
+    auto changed_fields = static_cast<sbar_field_t>(*this->changed_fields_);
+    *this->changed_fields_ = sbar_field_none;
+
+    if (changed_fields != sbar_field_none) {
+        this->read_controls();
+    }
+
+    return changed_fields;
+}
+
+std::vector<audio_monitor_t::control_t> audio_monitor_t::get_controls() const {
+    std::lock_guard lock{ *this->mutex_ };
+
+    return this->controls_;
+}
+
+} // namespace sbar
@@ -0,0 +1,122 @@
+#pragma once
+
+// Standard includes
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "../include/notify.h"
+
+namespace sbar {
+
+class audio_monitor_t;
+
+/**
+ * @brief Return a new monitor for the default ALSA mixer or an error.
+ */
+[[nodiscard]] res::optional_t<audio_monitor_t> get_audio_monitor();
+
+/**
+ * @brief Keeps the default ALSA mixer open, reports which audio fields are
+ * affected by volume and mute changes and keeps a copy of its controls up to
+ * date.
+ *
+ * @code{.cpp}
+ * auto audio_monitor = get_audio_monitor();
+ *
+ * for (int fd : audio_monitor->fds()) {
+ *     event_loop->add(fd, EPOLLIN, [&](uint32_t events) {
+ *         auto fields = audio_monitor->handle_events();
+ *         // ...
+ *     });
+ * }
+ *
+ * auto controls = audio_monitor->get_controls();
+ * @endcode
+ */
+class audio_monitor_t {
+  public:
+    /**
+     * @brief A value for each channel of a control or std::nullopt for
+     * channels that the control does not have.
+     */
+    template<typename value_t>
+    struct channels_t {
+        std::optional<value_t> front_left;
+        std::optional<value_t> front_center;
+        std::optional<value_t> front_right;
+        std::optional<value_t> side_left;
+        std::optional<value_t> woofer;
+        std::optional<value_t> side_right;
+        std::optional<value_t> rear_left;
+        std::optional<value_t> rear_center;
+        std::optional<value_t> rear_right;
+    };
+
+    /**
+     * @brief The state of a simple mixer control. Each member is std::nullopt
+     * if the control does not have that switch or volume.
+     */
+    struct control_t {
+        std::string name;
+        std::optional<channels_t<bool>> playback_status;   // unmuted
+        std::optional<channels_t<double>> playback_volume; // percent
+        std::optional<channels_t<bool>> capture_status;    // unmuted
+        std::optional<channels_t<double>> capture_volume;  // percent
+    };
+
+  private:
+    void* mixer_; // ALSA snd_mixer_t
+
+    // Shared with the ALSA callbacks so that it survives moves.
+    std::unique_ptr<unsigned long long> changed_fields_;
+
+    // the controls as of the last processed event
+    std::vector<control_t> controls_;
+
+    // Guards the controls, which are read from worker threads.
+    std::unique_ptr<std::mutex> mutex_;
+
+    audio_monitor_t(void* mixer);
+
+    friend res::optional_t<audio_monitor_t> get_audio_monitor();
+
+    /**
+     * @brief Copy the state of every control from the mixer.
+     */
+    void read_controls();
+
+  public:
+    audio_monitor_t(const audio_monitor_t&) = delete;
+    audio_monitor_t(audio_monitor_t&&) noexcept;
+    audio_monitor_t& operator=(const audio_monitor_t&) = delete;
+    audio_monitor_t& operator=(audio_monitor_t&&) noexcept = delete;
+
+    ~audio_monitor_t();
+
+    /**
+     * @brief Get the file descriptors that become readable when the mixer
+     * changes.
+     */
+    [[nodiscard]] std::vector<int> fds() const;
+
+    /**
+     * @brief Process pending mixer events.
+     *
+     * @return the top-level audio fields affected by the events or an error.
+     */
+    [[nodiscard]] res::optional_t<sbar_field_t> handle_events();
+
+    /**
+     * @brief Get the controls of the mixer as of the last processed event.
+     */
+    [[nodiscard]] std::vector<control_t> get_controls() const;
+};
+
+} // namespace sbar
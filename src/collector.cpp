@@ -0,0 +1,59 @@
+// Standard includes
+#include <array>
+#include <utility>
+
+// Local includes
+#include "collector.hpp"
+
+namespace sbar {
+
+namespace {
+
+// The fields that depend upon each collector.
+const std::array<std::pair<unsigned long long, collector_t>, 10> graph{ {
+  { sbar_field_cpu | sbar_field_cpu_per_core | sbar_field_context_switches
+      | sbar_field_interrupts | sbar_field_procs_running,
+    collector_cpu_usage },
+  { sbar_field_uptime | sbar_field_swap | sbar_field_memory | sbar_field_load_1
+      | sbar_field_load_5 | sbar_field_load_15 | sbar_field_memory_available
+      | sbar_field_memory_cached | sbar_field_memory_dirty,
+    collector_system_info },
+  { sbar_field_audio_playback | sbar_field_audio_capture,
+    collector_sound_mixer },
+  { sbar_field_disk, collector_disks },
+  { sbar_field_highest_temp | sbar_field_lowest_temp,
+    collector_thermal_zones },
+  { sbar_field_backlight, collector_backlights },
+  { sbar_field_battery, collector_batteries },
+  { sbar_field_network, collector_network_interfaces },
+  { sbar_field_kernel | sbar_field_outdated_kernel, collector_running_kernel },
+  { sbar_field_outdated_kernel, collector_installed_kernels },
+} };
+
+} // namespace
+
+collector_t get_collectors(sbar_field_t fields) {
+    unsigned collectors = collector_none;
+
+    for (const auto& [dependent_fields, collector] : graph) {
+        if ((fields & dependent_fields) != sbar_field_none) {
+            collectors |= collector;
+        }
+    }
+
+    return static_cast<collector_t>(collectors);
+}
+
+sbar_field_t get_dependent_fields(collector_t collectors) {
+    unsigned long long fields = sbar_field_none;
+
+    for (const auto& [dependent_fields, collector] : graph) {
+        if ((collectors & collector) != collector_none) {
+            fields |= dependent_fields;
+        }
+    }
+
+    return static_cast<sbar_field_t>(fields);
+}
+
+} // namespace sbar
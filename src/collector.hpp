@@ -0,0 +1,43 @@
+#pragma once
+
+// Local includes
+#include "../include/notify.h"
+
+namespace sbar {
+
+/**
+ * @brief Sources of system information that are gathered before the fields
+ * that depend on them are generated.
+ */
+enum collector_t : unsigned {
+    collector_none = 0U,
+    collector_cpu_usage = 1U,
+    collector_system_info = collector_cpu_usage << 1,
+    collector_sound_mixer = collector_system_info << 1,
+    collector_disks = collector_sound_mixer << 1,
+    collector_thermal_zones = collector_disks << 1,
+    collector_backlights = collector_thermal_zones << 1,
+    collector_batteries = collector_backlights << 1,
+    collector_network_interfaces = collector_batteries << 1,
+    collector_running_kernel = collector_network_interfaces << 1,
+    collector_installed_kernels = collector_running_kernel << 1,
+    collector_all = (collector_installed_kernels << 1) - 1,
+};
+
+/**
+ * @brief Get the collectors that must run before the given fields can be
+ * generated.
+ *
+ * @param[in] fields - The fields to be generated.
+ */
+[[nodiscard]] collector_t get_collectors(sbar_field_t fields);
+
+/**
+ * @brief Get the top-level fields that are generated from the given
+ * collectors.
+ *
+ * @param[in] collectors - The collectors that gathered new information.
+ */
+[[nodiscard]] sbar_field_t get_dependent_fields(collector_t collectors);
+
+} // namespace sbar
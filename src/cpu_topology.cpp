@@ -0,0 +1,233 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+
+// Local includes
+#include "cpu_topology.hpp"
+
+namespace sbar {
+
+namespace {
+
+/**
+ * @brief Parse a list of processors such as "0-3,8,10-11".
+ *
+ * @param[in] list - The list to parse.
+ */
+res::optional_t<std::vector<size_t>> parse_cpu_list(const std::string& list) {
+    std::vector<size_t> cpus;
+
+    size_t start = 0;
+    while (start < list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        auto range = list.substr(start, end - start);
+        start = end + 1;
+
+        unsigned long first = 0;
+        unsigned long last = 0;
+        int matched = std::sscanf(range.c_str(), "%lu-%lu", &first, &last);
+        if (matched == 1) {
+            last = first;
+        } else if (matched != 2 || last < first) {
+            return RES_NEW_ERROR(
+              "Failed to parse a list of processors: " + list);
+        }
+
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+/**
+ * @brief Read the first line of a sysfs attribute.
+ *
+ * @param[in] path - The path of the attribute.
+ */
+res::optional_t<std::string> read_line(const std::filesystem::path& path) {
+    std::ifstream file{ path };
+    std::string line;
+    if (! std::getline(file, line)) {
+        return RES_NEW_ERROR("Failed to read an attribute: " + path.string());
+    }
+
+    return line;
+}
+
+/**
+ * @brief Read the id of the group that a processor belongs to.
+ *
+ * @param[in] grouping - How the processors are grouped.
+ * @param[in] cpu_directory - The sysfs directory of the processor.
+ */
+res::optional_t<long> get_group_id(
+  cpu_grouping_t grouping, const std::filesystem::path& cpu_directory) {
+    std::filesystem::path attribute =
+      cpu_directory / "topology" / "physical_package_id";
+
+    switch (grouping) {
+        case cpu_grouping_t::socket:
+            break;
+        case cpu_grouping_t::cache: {
+            // Processors without a shared level 3 cache are grouped by
+            // socket.
+            auto cache_id = cpu_directory / "cache" / "index3" / "id";
+            std::error_code error;
+            if (std::filesystem::exists(cache_id, error)) {
+                attribute = cache_id;
+            }
+            break;
+        }
+        case cpu_grouping_t::numa: {
+            // The node of a processor is linked from its directory. Kernels
+            // without NUMA support have a single node.
+            std::error_code error;
+            for (const auto& entry :
+              std::filesystem::directory_iterator(cpu_directory, error)) {
+                auto name = entry.path().filename().string();
+                if (name.size() > 4 && name.compare(0, 4, "node") == 0
+                  && std::all_of(name.begin() + 4, name.end(), [](char chr) {
+                         return std::isdigit(static_cast<unsigned char>(chr));
+                     })) {
+                    return std::stol(name.substr(4));
+                }
+            }
+            return 0L;
+        }
+    }
+
+    auto id = read_line(attribute);
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    try {
+        return std::stol(id.value());
+    } catch (const std::exception& /*error*/) {
+        return RES_NEW_ERROR(
+          "Failed to parse the group of a processor: " + attribute.string());
+    }
+}
+
+} // namespace
+
+res::optional_t<cpu_topology_t> get_cpu_topology(
+  cpu_grouping_t grouping, const std::filesystem::path& cpu_directory) {
+    auto online = read_line(cpu_directory / "online");
+    if (online.has_error()) {
+        return RES_TRACE(online.error());
+    }
+
+    auto cpus = parse_cpu_list(online.value());
+    if (cpus.has_error()) {
+        return RES_TRACE(cpus.error());
+    }
+
+    // The group id and index of each online core.
+    std::vector<std::pair<long, size_t>> cores;
+    for (size_t index = 0; index < cpus->size(); ++index) {
+        auto group_id = get_group_id(grouping,
+          cpu_directory / ("cpu" + std::to_string(cpus->at(index))));
+        if (group_id.has_error()) {
+            return RES_TRACE(group_id.error());
+        }
+        cores.emplace_back(group_id.value(), index);
+    }
+
+    std::stable_sort(cores.begin(), cores.end());
+
+    std::vector<size_t> order;
+    std::vector<size_t> offsets;
+    for (size_t position = 0; position < cores.size(); ++position) {
+        if (position == 0
+          || cores.at(position).first != cores.at(position - 1).first) {
+            offsets.push_back(position);
+        }
+        order.push_back(cores.at(position).second);
+    }
+    offsets.push_back(order.size());
+
+    return cpu_topology_t{ std::move(order), std::move(offsets) };
+}
+
+cpu_topology_t::cpu_topology_t(
+  std::vector<size_t> order, std::vector<size_t> offsets)
+: order_(std::move(order))
+, offsets_(std::move(offsets))
+, gathered_(this->order_.size()) {
+}
+
+size_t cpu_topology_t::cores() const {
+    return this->order_.size();
+}
+
+size_t cpu_topology_t::groups() const {
+    return this->offsets_.size() - 1;
+}
+
+res::result_t cpu_topology_t::summarize(
+  const std::vector<double>& usage, std::vector<summary_t>& summaries) {
+    if (usage.size() != this->order_.size()) {
+        return RES_NEW_ERROR("The number of online processors changed from "
+          + std::to_string(this->order_.size()) + " to "
+          + std::to_string(usage.size()) + ".");
+    }
+
+    for (size_t position = 0; position < this->order_.size(); ++position) {
+        this->gathered_[position] = usage[this->order_[position]];
+    }
+
+    summaries.resize(this->groups());
+
+    // Independent lanes let the compiler vectorize the reductions without
+    // reordering the additions of any one lane.
+    constexpr size_t lanes = 4;
+    const double* values = this->gathered_.data();
+
+    for (size_t group = 0; group < this->groups(); ++group) {
+        size_t begin = this->offsets_[group];
+        size_t end = this->offsets_[group + 1];
+
+        std::array<double, lanes> lowest{};
+        std::array<double, lanes> highest{};
+        std::array<double, lanes> total{};
+        lowest.fill(std::numeric_limits<double>::infinity());
+        highest.fill(-std::numeric_limits<double>::infinity());
+
+        size_t position = begin;
+        for (; position + lanes <= end; position += lanes) {
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                double value = values[position + lane];
+                lowest[lane] = std::min(lowest[lane], value);
+                highest[lane] = std::max(highest[lane], value);
+                total[lane] += value;
+            }
+        }
+        for (; position < end; ++position) {
+            lowest[0] = std::min(lowest[0], values[position]);
+            highest[0] = std::max(highest[0], values[position]);
+            total[0] += values[position];
+        }
+
+        auto& summary = summaries[group];
+        summary.lowest = *std::min_element(lowest.begin(), lowest.end());
+        summary.highest = *std::max_element(highest.begin(), highest.end());
+        summary.average = (total[0] + total[1] + total[2] + total[3])
+          / static_cast<double>(end - begin);
+    }
+
+    return res::success;
+}
+
+} // namespace sbar
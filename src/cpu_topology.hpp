@@ -0,0 +1,104 @@
+#pragma once
+
+// Standard includes
+#include <filesystem>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+namespace sbar {
+
+class cpu_topology_t;
+
+/**
+ * @brief The groups that the cores of a cpu_topology_t are divided into.
+ */
+enum class cpu_grouping_t {
+    socket, // cores within the same physical package
+    cache,  // cores sharing a last-level cache (e.g. an AMD CCX)
+    numa,   // cores within the same NUMA node
+};
+
+/**
+ * @brief Read the topology of the online processors from sysfs or return an
+ * error.
+ *
+ * @param[in] grouping - How the cores are grouped.
+ * @param[in] cpu_directory - The sysfs directory of the processors.
+ */
+[[nodiscard]] res::optional_t<cpu_topology_t> get_cpu_topology(
+  cpu_grouping_t grouping,
+  const std::filesystem::path& cpu_directory = "/sys/devices/system/cpu");
+
+/**
+ * @brief Summarizes the usage of many cores as the lowest, average and
+ * highest usage of each group of cores.
+ *
+ * Cores are reordered by group once, so summarizing is a single gather
+ * followed by a pass over contiguous values that the compiler can vectorize.
+ *
+ * @code{.cpp}
+ * auto topology = get_cpu_topology(cpu_grouping_t::socket);
+ * if (topology.has_error()) {
+ *     std::cerr << topology.error() << std::endl;
+ *     return 1;
+ * }
+ *
+ * std::vector<cpu_topology_t::summary_t> summaries;
+ * topology->summarize(cpu_usage.get_per_core().value(), summaries);
+ * @endcode
+ */
+class cpu_topology_t {
+  public:
+    /**
+     * @brief The usage of the cores of a group.
+     */
+    struct summary_t {
+        double lowest = 0;
+        double average = 0;
+        double highest = 0;
+    };
+
+  private:
+    // the indices of the online cores ordered by group
+    std::vector<size_t> order_;
+
+    // the first position within order_ of each group followed by the number
+    // of cores
+    std::vector<size_t> offsets_;
+
+    // the usage of each core ordered by group
+    std::vector<double> gathered_;
+
+    cpu_topology_t(std::vector<size_t> order, std::vector<size_t> offsets);
+
+    friend res::optional_t<cpu_topology_t> get_cpu_topology(
+      cpu_grouping_t grouping, const std::filesystem::path& cpu_directory);
+
+  public:
+    /**
+     * @brief Get the number of online cores.
+     */
+    [[nodiscard]] size_t cores() const;
+
+    /**
+     * @brief Get the number of groups.
+     */
+    [[nodiscard]] size_t groups() const;
+
+    /**
+     * @brief Summarize the usage of each group in ascending order of the id
+     * of the group. Does not allocate once the summaries have been sized.
+     *
+     * @param[in] usage - The usage of each online core in ascending order of
+     * the number of the core.
+     * @param[out] summaries - The summary of each group.
+     * @return a result indicating success or failure. Fails if the number of
+     * online cores has changed.
+     */
+    res::result_t summarize(
+      const std::vector<double>& usage, std::vector<summary_t>& summaries);
+};
+
+} // namespace sbar
@@ -0,0 +1,132 @@
+// Standard includes
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+// External includes
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+// Local includes
+#include "device_monitor.hpp"
+
+namespace sbar {
+
+namespace {
+
+/**
+ * @brief Get the collector that reads devices of the given subsystem.
+ */
+collector_t get_subsystem_collector(std::string_view subsystem) {
+    if (subsystem == "power_supply") {
+        return collector_batteries;
+    }
+    if (subsystem == "backlight") {
+        return collector_backlights;
+    }
+    if (subsystem == "block") {
+        return collector_disks;
+    }
+    if (subsystem == "thermal") {
+        return collector_thermal_zones;
+    }
+    return collector_none;
+}
+
+} // namespace
+
+res::optional_t<device_monitor_t> get_device_monitor() {
+    int fd = socket(AF_NETLINK,
+      SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+      NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to open a uevent netlink socket.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    device_monitor_t device_monitor{ fd_t{ fd } };
+
+    // Group 1 carries the events sent by the kernel (as opposed to udev).
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1;
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to subscribe to device events.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return device_monitor;
+}
+
+device_monitor_t::device_monitor_t(fd_t fd) : fd_(std::move(fd)) {
+}
+
+int device_monitor_t::fd() const {
+    return this->fd_.get();
+}
+
+res::optional_t<device_monitor_t::events_t> device_monitor_t::handle_events() {
+    // The kernel limits the environment of an event to 2048 bytes.
+    const size_t buffer_size = 8192;
+    std::array<char, buffer_size> buffer{};
+
+    unsigned added_or_removed = collector_none;
+    unsigned changed = collector_none;
+
+    while (true) {
+        auto length = recv(this->fd_.get(), buffer.data(), buffer.size(), 0);
+        if (length < 0) {
+            if (errno == EAGAIN) {
+                break;
+            }
+            if (errno == ENOBUFS) {
+                // Events were dropped. Assume every device may have changed.
+                added_or_removed |= collectors;
+                continue;
+            }
+            return RES_NEW_ERROR(
+              std::string{ "Failed to receive device events.\n\terror: " }
+              + std::strerror(errno));
+        }
+
+        // ACTION@DEVPATH\0KEY=VALUE\0KEY=VALUE\0...
+        std::string_view action;
+        std::string_view subsystem;
+
+        std::string_view message{ buffer.data(), static_cast<size_t>(length) };
+        while (! message.empty()) {
+            auto end = message.find('\0');
+            auto entry = message.substr(0, end);
+            message.remove_prefix(
+              end == std::string_view::npos ? message.size() : end + 1);
+
+            if (entry.rfind("ACTION=", 0) == 0) {
+                action = entry.substr(std::strlen("ACTION="));
+            } else if (entry.rfind("SUBSYSTEM=", 0) == 0) {
+                subsystem = entry.substr(std::strlen("SUBSYSTEM="));
+            }
+        }
+
+        auto collector = get_subsystem_collector(subsystem);
+        if (collector == collector_none) {
+            continue;
+        }
+
+        if (action == "add" || action == "remove" || action == "move") {
+            added_or_removed |= collector;
+        } else if (action == "change" || action == "online"
+          || action == "offline") {
+            changed |= collector;
+        }
+    }
+
+    return events_t{ static_cast<collector_t>(added_or_removed),
+        static_cast<collector_t>(changed) };
+}
+
+} // namespace sbar
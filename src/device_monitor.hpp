@@ -0,0 +1,76 @@
+#pragma once
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "collector.hpp"
+#include "fd.hpp"
+
+namespace sbar {
+
+class device_monitor_t;
+
+/**
+ * @brief Return a new monitor for kernel device events (uevents) or an error.
+ */
+[[nodiscard]] res::optional_t<device_monitor_t> get_device_monitor();
+
+/**
+ * @brief Reports which device collectors are affected by devices being added,
+ * removed or changed.
+ *
+ * Only the subsystems read by collectors are reported: power_supply
+ * (batteries), backlight (backlights), block (disks) and thermal (thermal
+ * zones).
+ *
+ * @code{.cpp}
+ * auto device_monitor = get_device_monitor();
+ *
+ * event_loop->add(device_monitor->fd(), EPOLLIN, [&](uint32_t events) {
+ *     auto device_events = device_monitor->handle_events();
+ *     // re-enumerate device_events->added_or_removed
+ *     // refresh the fields of device_events->changed
+ * });
+ * @endcode
+ */
+class device_monitor_t {
+    fd_t fd_;
+
+    device_monitor_t(fd_t fd);
+
+    friend res::optional_t<device_monitor_t> get_device_monitor();
+
+  public:
+    /**
+     * @brief The collectors affected by the events read by handle_events.
+     */
+    struct events_t {
+        // collectors whose devices were added or removed
+        collector_t added_or_removed = collector_none;
+
+        // collectors whose devices changed state
+        collector_t changed = collector_none;
+    };
+
+    /**
+     * @brief The collectors that can be kept current by this monitor.
+     */
+    static constexpr collector_t collectors = static_cast<collector_t>(
+      collector_disks | collector_thermal_zones | collector_backlights
+      | collector_batteries);
+
+    /**
+     * @brief Get the file descriptor of this monitor.
+     */
+    [[nodiscard]] int fd() const;
+
+    /**
+     * @brief Read every pending device event without blocking.
+     *
+     * @return the collectors affected by the events or an error.
+     */
+    [[nodiscard]] res::optional_t<events_t> handle_events();
+};
+
+} // namespace sbar
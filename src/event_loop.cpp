@@ -0,0 +1,98 @@
+// Standard includes
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// External includes
+#include <sys/epoll.h>
+
+// Local includes
+#include "event_loop.hpp"
+
+namespace sbar {
+
+res::optional_t<event_loop_t> get_event_loop() {
+    int fd = epoll_create1(EPOLL_CLOEXEC);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to create an event loop.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return event_loop_t{ fd_t{ fd } };
+}
+
+event_loop_t::event_loop_t(fd_t fd) : fd_(std::move(fd)) {
+}
+
+res::result_t event_loop_t::add(int fd, uint32_t events, callback_t callback) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+
+    if (epoll_ctl(this->fd_.get(), EPOLL_CTL_ADD, fd, &event) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to add a file descriptor to the event "
+                       "loop.\n\tfd: " }
+          + std::to_string(fd) + "\n\terror: " + std::strerror(errno));
+    }
+
+    this->callbacks_[fd] = std::make_shared<callback_t>(std::move(callback));
+
+    return res::success;
+}
+
+res::result_t event_loop_t::remove(int fd) {
+    if (epoll_ctl(this->fd_.get(), EPOLL_CTL_DEL, fd, nullptr) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to remove a file descriptor from the event "
+                       "loop.\n\tfd: " }
+          + std::to_string(fd) + "\n\terror: " + std::strerror(errno));
+    }
+
+    // The callback is kept if the file descriptor is still watched.
+    this->callbacks_.erase(fd);
+
+    return res::success;
+}
+
+res::result_t event_loop_t::wait(
+  std::optional<std::chrono::milliseconds> timeout) {
+    const size_t max_events = 16;
+    std::array<epoll_event, max_events> events{};
+
+    int timeout_ms = -1;
+    if (timeout.has_value()) {
+        timeout_ms = static_cast<int>(timeout->count());
+    }
+
+    int ready =
+      epoll_wait(this->fd_.get(), events.data(), max_events, timeout_ms);
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return res::success;
+        }
+        return RES_NEW_ERROR(
+          std::string{ "Failed to wait for events.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    for (int index = 0; index < ready; ++index) {
+        const auto& event = events.at(index);
+
+        // The callback may have been removed by a previous callback.
+        auto callback = this->callbacks_.find(event.data.fd);
+        if (callback == this->callbacks_.end()) {
+            continue;
+        }
+
+        auto function = callback->second;
+        (*function)(event.events);
+    }
+
+    return res::success;
+}
+
+} // namespace sbar
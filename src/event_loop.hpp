@@ -0,0 +1,98 @@
+#pragma once
+
+// Standard includes
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+class event_loop_t;
+
+/**
+ * @brief Return a new event loop or an error.
+ */
+[[nodiscard]] res::optional_t<event_loop_t> get_event_loop();
+
+/**
+ * @brief Waits for file descriptors to become ready and dispatches their
+ * callbacks (epoll).
+ *
+ * @code{.cpp}
+ * auto event_loop = get_event_loop();
+ * if (event_loop.failure()) {
+ *     std::cerr << event_loop.error() << std::endl;
+ *     return 1;
+ * }
+ *
+ * event_loop->add(timer->fd(), EPOLLIN, [&](uint32_t events) {
+ *     // ...
+ * });
+ *
+ * while (keep_running) {
+ *     event_loop->wait();
+ * }
+ * @endcode
+ */
+class event_loop_t {
+  public:
+    /**
+     * @brief Called with the epoll events reported for a file descriptor.
+     * EPOLLERR and EPOLLHUP are reported even if they were not requested, and
+     * a file descriptor that reports them may stay ready until it is removed.
+     */
+    using callback_t = std::function<void(uint32_t events)>;
+
+  private:
+    fd_t fd_;
+
+    // Callbacks are boxed so that they stay valid while being dispatched.
+    std::unordered_map<int, std::shared_ptr<callback_t>> callbacks_;
+
+    event_loop_t(fd_t fd);
+
+    friend res::optional_t<event_loop_t> get_event_loop();
+
+  public:
+    /**
+     * @brief Call a function whenever a file descriptor becomes ready.
+     *
+     * @param[in] fd - The file descriptor to watch. It must outlive its
+     * registration.
+     * @param[in] events - The epoll events to wait for (e.g. EPOLLIN).
+     * @param[in] callback - The function to call.
+     * @return a result indicating success or failure.
+     */
+    res::result_t add(int fd, uint32_t events, callback_t callback);
+
+    /**
+     * @brief Stop watching a file descriptor.
+     *
+     * @param[in] fd - The file descriptor to stop watching.
+     * @return a result indicating success or failure.
+     */
+    res::result_t remove(int fd);
+
+    /**
+     * @brief Wait for at least one file descriptor to become ready and call
+     * the callbacks of every ready file descriptor.
+     *
+     * @param[in] timeout - The longest time to wait or std::nullopt to wait
+     * indefinitely.
+     * @return a result indicating success or failure. Being interrupted by
+     * a signal is not a failure.
+     */
+    res::result_t wait(
+      std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+};
+
+} // namespace sbar
@@ -0,0 +1,37 @@
+// External includes
+#include <unistd.h>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+fd_t::fd_t(int fd) noexcept : fd_(fd) {
+}
+
+fd_t::fd_t(fd_t&& fd) noexcept : fd_(fd.fd_) {
+    fd.fd_ = -1;
+}
+
+fd_t& fd_t::operator=(fd_t&& fd) noexcept {
+    if (this != &fd) {
+        if (this->fd_ >= 0) {
+            close(this->fd_);
+        }
+        this->fd_ = fd.fd_;
+        fd.fd_ = -1;
+    }
+    return *this;
+}
+
+fd_t::~fd_t() {
+    if (this->fd_ >= 0) {
+        close(this->fd_);
+    }
+}
+
+int fd_t::get() const {
+    return this->fd_;
+}
+
+} // namespace sbar
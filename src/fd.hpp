@@ -0,0 +1,27 @@
+#pragma once
+
+namespace sbar {
+
+/**
+ * @brief Owns a file descriptor and closes it when destroyed.
+ */
+class fd_t {
+    int fd_;
+
+  public:
+    explicit fd_t(int fd = -1) noexcept;
+
+    fd_t(const fd_t&) = delete;
+    fd_t(fd_t&& fd) noexcept;
+    fd_t& operator=(const fd_t&) = delete;
+    fd_t& operator=(fd_t&& fd) noexcept;
+
+    ~fd_t();
+
+    /**
+     * @brief Get the owned file descriptor or -1 if none is owned.
+     */
+    [[nodiscard]] int get() const;
+};
+
+} // namespace sbar
@@ -0,0 +1,66 @@
+// Standard includes
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// External includes
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Local includes
+#include "file_watcher.hpp"
+
+namespace sbar {
+
+res::optional_t<file_watcher_t> get_file_watcher() {
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to create a file watcher.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return file_watcher_t{ fd_t{ fd } };
+}
+
+file_watcher_t::file_watcher_t(fd_t fd) : fd_(std::move(fd)) {
+}
+
+int file_watcher_t::fd() const {
+    return this->fd_.get();
+}
+
+res::result_t file_watcher_t::watch(
+  const std::filesystem::path& path, uint32_t mask) {
+    if (inotify_add_watch(this->fd_.get(), path.c_str(), mask) < 0) {
+        return RES_NEW_ERROR(std::string{ "Failed to watch a path.\n\tpath: " }
+          + path.string() + "\n\terror: " + std::strerror(errno));
+    }
+
+    return res::success;
+}
+
+res::optional_t<bool> file_watcher_t::drain() {
+    const size_t buffer_size = 4096;
+    alignas(inotify_event) std::array<char, buffer_size> buffer{};
+
+    bool pending = false;
+
+    while (true) {
+        auto length = read(this->fd_.get(), buffer.data(), buffer.size());
+        if (length > 0) {
+            pending = true;
+            continue;
+        }
+        if (length < 0 && errno != EAGAIN) {
+            return RES_NEW_ERROR(
+              std::string{ "Failed to read file events.\n\terror: " }
+              + std::strerror(errno));
+        }
+        return pending;
+    }
+}
+
+} // namespace sbar
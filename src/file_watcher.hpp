@@ -0,0 +1,66 @@
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <filesystem>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+class file_watcher_t;
+
+/**
+ * @brief Return a new non-blocking file watcher or an error.
+ */
+[[nodiscard]] res::optional_t<file_watcher_t> get_file_watcher();
+
+/**
+ * @brief Reports changes to files and directories (inotify).
+ *
+ * @code{.cpp}
+ * auto watcher = get_file_watcher();
+ * watcher->watch("/usr/lib/modules", IN_CREATE | IN_DELETE);
+ *
+ * event_loop->add(watcher->fd(), EPOLLIN, [&](uint32_t events) {
+ *     if (watcher->drain().value()) {
+ *         // ...
+ *     }
+ * });
+ * @endcode
+ */
+class file_watcher_t {
+    fd_t fd_;
+
+    file_watcher_t(fd_t fd);
+
+    friend res::optional_t<file_watcher_t> get_file_watcher();
+
+  public:
+    /**
+     * @brief Get the file descriptor of this watcher.
+     */
+    [[nodiscard]] int fd() const;
+
+    /**
+     * @brief Report changes to a file or the contents of a directory.
+     *
+     * @param[in] path - The file or directory to watch.
+     * @param[in] mask - The inotify events to report (e.g. IN_CREATE).
+     * @return a result indicating success or failure.
+     */
+    res::result_t watch(const std::filesystem::path& path, uint32_t mask);
+
+    /**
+     * @brief Discard every pending event without blocking.
+     *
+     * @return true if any events were pending, false otherwise, or an error.
+     */
+    [[nodiscard]] res::optional_t<bool> drain();
+};
+
+} // namespace sbar
@@ -0,0 +1,100 @@
+// Standard includes
+#include <algorithm>
+
+// Local includes
+#include "format.hpp"
+
+namespace sbar {
+
+res::optional_t<format_t> compile_format(const std::string& fmt,
+  field_assigner_t field_assigner,
+  field_assigner_t history_assigner) {
+    format_t format;
+
+    auto append_literal = [&format](char chr) {
+        if (format.segments.empty()
+          || format.segments.back().field != sbar_field_none) {
+            format.segments.push_back(segment_t{
+              sbar_field_none, 0, false, format.literals.size(), 0 });
+        }
+        format.literals += chr;
+        format.segments.back().length++;
+    };
+
+    bool escaped = false;
+    bool history = false;
+    for (char chr : fmt) {
+        if (history) {
+            history = false;
+
+            sbar_field_t field = history_assigner(chr);
+            if (field == sbar_field_none) {
+                return RES_NEW_ERROR(std::string{ "Invalid history token: '" }
+                  + escape_seq + history_seq + chr + "'\n\tformat: " + fmt);
+            }
+
+            format.segments.push_back(segment_t{ field,
+              static_cast<size_t>(__builtin_ctzll(field))
+                + history_index_offset,
+              true,
+              0,
+              0 });
+            format.fields = static_cast<sbar_field_t>(format.fields | field);
+            format.history_fields =
+              static_cast<sbar_field_t>(format.history_fields | field);
+            continue;
+        }
+
+        if (! escaped) {
+            if (chr == escape_seq) {
+                escaped = true;
+            } else {
+                append_literal(chr);
+            }
+            continue;
+        }
+
+        escaped = false;
+
+        if (chr == escape_seq) {
+            append_literal(chr);
+            continue;
+        }
+
+        if (chr == history_seq && history_assigner != nullptr) {
+            history = true;
+            continue;
+        }
+
+        sbar_field_t field = field_assigner(chr);
+        if (field == sbar_field_none) {
+            return RES_NEW_ERROR(std::string{ "Invalid escaped token: '" }
+              + escape_seq + chr + "'\n\tformat: " + fmt);
+        }
+
+        if ((field & extended_field) != 0) {
+            format.segments.push_back(segment_t{ field, 0, false, 0, 0 });
+            continue;
+        }
+
+        format.segments.push_back(segment_t{
+          field, static_cast<size_t>(__builtin_ctzll(field)), false, 0, 0 });
+        format.fields = static_cast<sbar_field_t>(format.fields | field);
+    }
+
+    if (escaped || history) {
+        return RES_NEW_ERROR(
+          "Incomplete escape sequence at the end of the format.\n\tformat: "
+          + fmt);
+    }
+
+    return format;
+}
+
+bool has_field(const format_t& format, sbar_field_t field) {
+    return std::any_of(format.segments.begin(),
+      format.segments.end(),
+      [field](const segment_t& segment) { return segment.field == field; });
+}
+
+} // namespace sbar
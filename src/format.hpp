@@ -0,0 +1,106 @@
+#pragma once
+
+// Standard includes
+#include <string>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "../include/notify.h"
+
+namespace sbar {
+
+/**
+ * @brief The character that introduces a token within a format string.
+ */
+const char escape_seq = '/';
+
+/**
+ * @brief The character that follows escape_seq to select the history of a
+ * field instead of its current value (e.g. "/~W").
+ */
+const char history_seq = '~';
+
+/**
+ * @brief Added to the index of a field to get the index of its history.
+ */
+const size_t history_index_offset = 64;
+
+/**
+ * @brief Set on fields that only appear within sub-formats and do not fit in
+ * the bits of sbar_field_t. Extended fields are never notified or scheduled,
+ * so they only need to be distinct within their own sub-format. They are
+ * left out of format_t::fields.
+ */
+const unsigned long long extended_field = 1ULL << 63;
+
+/**
+ * @brief Get the extended field with the given id.
+ *
+ * @param[in] id - An id that is unique within a sub-format.
+ */
+[[nodiscard]] constexpr sbar_field_t make_extended_field(
+  unsigned long long id) {
+    return static_cast<sbar_field_t>(extended_field | id);
+}
+
+/**
+ * @brief Returns the field represented by a token or sbar_field_none if the
+ * token is not recognized.
+ */
+using field_assigner_t = sbar_field_t (*)(char);
+
+/**
+ * @brief A single piece of a compiled format.
+ *
+ * Segments with a field of sbar_field_none are literal text spanning
+ * [offset, offset + length) within format_t::literals.
+ */
+struct segment_t {
+    sbar_field_t field = sbar_field_none;
+    size_t index = 0; // __builtin_ctzll(field) for non-extended fields
+    bool history = false; // plus history_index_offset if set
+    size_t offset = 0;
+    size_t length = 0;
+};
+
+/**
+ * @brief A format string that has been parsed into literal spans and field
+ * slots.
+ */
+struct format_t {
+    std::string literals;
+    std::vector<segment_t> segments;
+
+    // the union of every non-extended field referenced by this format
+    sbar_field_t fields = sbar_field_none;
+
+    // the fields whose history is referenced by this format
+    sbar_field_t history_fields = sbar_field_none;
+};
+
+/**
+ * @brief Check whether a format references a field. Unlike format_t::fields,
+ * this also works for extended fields.
+ *
+ * @param[in] format - The compiled format.
+ * @param[in] field - The field to look for.
+ */
+[[nodiscard]] bool has_field(const format_t& format, sbar_field_t field);
+
+/**
+ * @brief Parse a format string into a format_t.
+ * Returns an error if the format contains an unrecognized token.
+ *
+ * @param[in] fmt - The format string to compile.
+ * @param[in] field_assigner - Maps the tokens of this format to fields.
+ * @param[in] history_assigner - Maps the tokens that may follow history_seq
+ * to fields or nullptr if this format has no history tokens.
+ */
+[[nodiscard]] res::optional_t<format_t> compile_format(const std::string& fmt,
+  field_assigner_t field_assigner,
+  field_assigner_t history_assigner = nullptr);
+
+} // namespace sbar
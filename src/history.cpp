@@ -0,0 +1,80 @@
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+// Local includes
+#include "history.hpp"
+
+namespace sbar {
+
+namespace {
+
+// Block characters from the lowest to the highest level.
+const std::array<const char*, 8> blocks{
+    "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█",
+};
+
+} // namespace
+
+const char* get_block(double value, double lowest, double highest) {
+    double range = highest - lowest;
+
+    double level = 0;
+    if (range > 0) {
+        level = std::round((value - lowest) / range
+          * static_cast<double>(blocks.size() - 1));
+    }
+    level = std::clamp(level, 0.0, static_cast<double>(blocks.size() - 1));
+
+    return blocks.at(static_cast<size_t>(level));
+}
+
+void history_t::push(double value) {
+    this->samples_.at(this->next_) = static_cast<float>(value);
+    this->next_ = (this->next_ + 1) % capacity;
+    this->size_ = std::min(this->size_ + 1, capacity);
+}
+
+size_t history_t::size() const {
+    return this->size_;
+}
+
+std::string history_t::sparkline(size_t width,
+  std::optional<double> lowest,
+  std::optional<double> highest) const {
+    std::string status;
+    this->append_sparkline(status, width, lowest, highest);
+    return status;
+}
+
+void history_t::append_sparkline(std::string& output,
+  size_t width,
+  std::optional<double> lowest,
+  std::optional<double> highest) const {
+    width = std::min(width, this->size_);
+
+    // The index of the oldest rendered sample.
+    size_t first = (this->next_ + capacity - width) % capacity;
+
+    auto sample = [this, first](size_t index) {
+        return static_cast<double>(
+          this->samples_.at((first + index) % capacity));
+    };
+
+    if (! lowest.has_value() || ! highest.has_value()) {
+        double low = width == 0 ? 0 : sample(0);
+        double high = low;
+        for (size_t index = 1; index < width; ++index) {
+            low = std::min(low, sample(index));
+            high = std::max(high, sample(index));
+        }
+        lowest = lowest.value_or(low);
+        highest = highest.value_or(high);
+    }
+
+    for (size_t index = 0; index < width; ++index) {
+        output += get_block(sample(index), lowest.value(), highest.value());
+    }
+}
+
+} // namespace sbar
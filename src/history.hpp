@@ -0,0 +1,90 @@
+#pragma once
+
+// Standard includes
+#include <array>
+#include <optional>
+#include <string>
+
+namespace sbar {
+
+/**
+ * @brief Get the block character (▁ to █) that represents a value within a
+ * range. Values outside of the range are clamped to it.
+ *
+ * @param[in] value - The value to represent.
+ * @param[in] lowest - The value drawn as ▁.
+ * @param[in] highest - The value drawn as █.
+ */
+[[nodiscard]] const char* get_block(
+  double value, double lowest, double highest);
+
+/**
+ * @brief The most recent samples of a metric, kept in a ring buffer of fixed
+ * size so that recording a sample never allocates.
+ *
+ * @code{.cpp}
+ * history_t history;
+ *
+ * history.push(cpu_usage);
+ * // ...
+ * history.push(cpu_usage);
+ *
+ * // The last 20 samples on a scale of 0 to 100.
+ * auto status = history.sparkline(20, 0, 100);
+ * @endcode
+ */
+class history_t {
+  public:
+    /**
+     * @brief The maximum number of samples kept.
+     */
+    static constexpr size_t capacity = 60;
+
+  private:
+    std::array<float, capacity> samples_{};
+    size_t next_ = 0;
+    size_t size_ = 0;
+
+  public:
+    /**
+     * @brief Record a sample, replacing the oldest sample once full.
+     *
+     * @param[in] value - The value of the metric.
+     */
+    void push(double value);
+
+    /**
+     * @brief Get the number of samples kept.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Render the most recent samples as a row of block characters
+     * (▁ to █), oldest first.
+     *
+     * @param[in] width - The maximum number of samples to render.
+     * @param[in] lowest - The value drawn as ▁. Defaults to the lowest
+     * rendered sample.
+     * @param[in] highest - The value drawn as █. Defaults to the highest
+     * rendered sample.
+     */
+    [[nodiscard]] std::string sparkline(size_t width,
+      std::optional<double> lowest = std::nullopt,
+      std::optional<double> highest = std::nullopt) const;
+
+    /**
+     * @brief Append the sparkline of the most recent samples to a string.
+     * Does not allocate unless the string must grow.
+     *
+     * @param[in, out] output - The string to append to.
+     * @param[in] width - The maximum number of samples to render.
+     * @param[in] lowest - The value drawn as ▁.
+     * @param[in] highest - The value drawn as █.
+     */
+    void append_sparkline(std::string& output,
+      size_t width,
+      std::optional<double> lowest = std::nullopt,
+      std::optional<double> highest = std::nullopt) const;
+};
+
+} // namespace sbar
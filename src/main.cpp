@@ -1,180 +1,713 @@
 // Standard includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <charconv>
 #include <filesystem>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <chrono>
+#include <cmath>
 #include <csignal>
 #include <cstdio>
+#include <cstdlib>
 #include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 
 // External includes
 #include <argparse/argparse.hpp>
 #include <cpp_result/all.hpp>
 #include <inotify_ipc/iipc.hpp>
 #include <system_state/system_state.hpp>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
 
 // Local includes
 #include "../build/version.h"
 #include "root_window.hpp"
 #include "../include/notify.h"
 #include "channel.hpp"
-
-using std::invalid_argument;
+#include "collector.hpp"
+#include "format.hpp"
+#include "scheduler.hpp"
+#include "timer.hpp"
+#include "event_loop.hpp"
+#include "file_watcher.hpp"
+#include "signals.hpp"
+#include "audio_monitor.hpp"
+#include "network_monitor.hpp"
+#include "device_monitor.hpp"
+#include "worker_pool.hpp"
+#include "mount_prober.hpp"
+#include "sysfs_cache.hpp"
+#include "rate_tracker.hpp"
+#include "history.hpp"
+#include "cpu_topology.hpp"
+#include "proc_reader.hpp"
+#include "number_format.hpp"
+#include "value_filter.hpp"
+#include "status_buffer.hpp"
 
 namespace ch = std::chrono;
 
 const std::string error_status = "❌";
 
-bool keep_running = true;
+/**
+ * @brief Readings shared by every field generated by a job so that each is
+ * taken at most once per job. Each reading belongs to the collector noted
+ * beside it. Only the job that owns a collector touches its readings, so
+ * they need no lock. A reading that was not taken by the current job is
+ * empty, and its entry is kept until the devices are enumerated again.
+ */
+struct snapshot_t {
+    template<typename value_t>
+    using readings_t = std::unordered_map<std::string,
+      std::optional<res::optional_t<value_t>>>;
+
+    // collector_disks
+    readings_t<std::vector<syst::part_t>> parts;
+    readings_t<syst::mount_info_t> mount_infos;
+
+    // collector_thermal_zones
+    readings_t<double> temperatures;
+
+    // collector_batteries
+    readings_t<syst::battery_t::status_t> battery_statuses;
+    readings_t<double> battery_charges;
+
+    // collector_network_interfaces
+    readings_t<syst::network_interface_t::stat_t> network_stats;
+};
+
+/**
+ * @brief The sysfs attributes read from a disk or partition.
+ */
+struct block_attributes_t {
+    std::filesystem::path stat;
+    std::filesystem::path in_flight;
+};
+
+/**
+ * @brief The sysfs attributes read from a backlight.
+ */
+struct backlight_attributes_t {
+    std::filesystem::path brightness;
+    std::filesystem::path max_brightness;
+};
+
+/**
+ * @brief The sysfs attributes read from a battery.
+ */
+struct battery_attributes_t {
+    std::filesystem::path status;
+    std::filesystem::path capacity;
+};
+
+// The metrics whose history can be shown with a history token of --status.
+enum history_metric_t : size_t {
+    history_cpu,          // collector_cpu_usage
+    history_memory,       // collector_system_info
+    history_highest_temp, // collector_thermal_zones
+    history_network,      // collector_network_interfaces
+    history_metrics,
+};
+
+// How the usage of each core is shown (see --per-core).
+enum class per_core_mode_t {
+    values, // the usage of every core
+    glyphs, // a block character for every core
+    groups, // the lowest, average and highest usage of each group of cores
+};
+
+struct persistent_state_t {
+    // compiled formats
+    sbar::format_t status_fmt;
+    sbar::format_t disk_fmt;
+    sbar::format_t part_fmt;
+    sbar::format_t backlight_fmt;
+    sbar::format_t battery_fmt;
+    sbar::format_t network_fmt;
+    sbar::format_t audio_playback_fmt;
+    sbar::format_t audio_capture_fmt;
+
+    // options
+    bool ignore_zero_capacity_disks = true;
+    ch::milliseconds mount_timeout{ 250 };
+    size_t sparkline_width = 20;
+    per_core_mode_t per_core_mode = per_core_mode_t::values;
+
+    // persistent system_info structures
+    std::optional<sbar::system_info_t> system_info;
+    std::optional<std::vector<sbar::audio_monitor_t::control_t>> audio_controls;
+    sbar::cpu_usage_t cpu_usage;
+
+    // files read by collector_cpu_usage and collector_system_info
+    sbar::proc_file_t proc_stat{ "/proc/stat" };
+    sbar::proc_file_t proc_meminfo{ "/proc/meminfo" };
+    sbar::proc_file_t proc_loadavg{ "/proc/loadavg" };
+    std::optional<std::vector<syst::disk_t>> disks;
+    std::optional<std::vector<std::filesystem::path>> thermal_zones;
+    std::optional<std::vector<syst::backlight_t>> backlights;
+    std::optional<std::vector<syst::battery_t>> batteries;
+    std::optional<std::vector<syst::network_interface_t>> network_interfaces;
+    // cleared by the main thread if the monitor fails
+    std::atomic<const sbar::network_monitor_t*> network_monitor = nullptr;
+    // replaced by the main thread while jobs may read it, so it is only
+    // accessed through std::atomic_load and std::atomic_store
+    std::shared_ptr<const sbar::audio_monitor_t> audio_monitor;
+    sbar::mount_prober_t mount_prober;
+    sbar::sysfs_cache_t sysfs_cache;
+    snapshot_t snapshot;
+
+    // the sysfs attributes of each device, found when the devices are
+    // enumerated, and the buffers that they are read into (owned by the
+    // collector of the devices)
+    std::unordered_map<std::string, block_attributes_t> block_attributes;
+    std::unordered_map<std::string, backlight_attributes_t>
+      backlight_attributes;
+    std::unordered_map<std::string, battery_attributes_t> battery_attributes;
+    std::string block_attribute;
+    std::string battery_attribute;
+
+    // bytes down, bytes up, packets down and packets up per second of each
+    // network interface (owned by collector_network_interfaces)
+    sbar::rate_tracker_t<4> network_rates;
+
+    // sectors read, sectors written, reads, writes and milliseconds spent
+    // doing I/O per second of each disk and partition (owned by
+    // collector_disks)
+    sbar::rate_tracker_t<5> block_rates;
+
+    // recent samples of each metric (owned by the collector noted beside
+    // the metric)
+    std::array<sbar::history_t, history_metrics> histories;
+
+    // filters of numeric fields set by --quantize and --hysteresis, keyed by
+    // the field that expands their sub-format (sbar_field_none at the top
+    // level) and the field itself (owned by the job of the top-level field
+    // that shows them)
+    std::map<std::pair<sbar_field_t, sbar_field_t>, sbar::value_filter_t>
+      value_filters;
+
+    // the groups of cores and their usage (owned by collector_cpu_usage)
+    std::optional<sbar::cpu_topology_t> cpu_topology;
+    std::vector<sbar::cpu_topology_t::summary_t> cpu_summaries;
+    std::optional<std::string> running_kernel;
+    std::optional<std::vector<std::string>> installed_kernels;
+
+    // collectors whose sources report their own changes (the running kernel
+    // never changes)
+    sbar::collector_t event_driven_collectors = sbar::collector_running_kernel;
+
+    // event-driven collectors that must run again
+    sbar::collector_t stale_collectors = sbar::collector_all;
+
+    // fields reachable from the compiled formats
+    sbar_field_t active_fields = sbar_field_all;
+
+    // fields to update
+    sbar_field_t fields_to_update = sbar_field_all;
+
+    // the value of each slot of the status, generated in place by the job
+    // that owns its field so that the buffers keep their capacity between
+    // renders (see segment_t::index)
+    std::array<std::string, 2 * sbar::history_index_offset> field_values;
+
+    // the status assembled from the saved values of the top-level fields
+    sbar::status_buffer_t status;
+};
+
+/**
+ * @brief Take a reading unless it was already taken by the current job.
+ *
+ * @param[in, out] readings - The readings taken by the current job.
+ * @param[in] key - The device or file that the reading belongs to.
+ * @param[in] read - Takes the reading.
+ * @return the reading, which is valid until the readings are cleared.
+ */
+template<typename value_t, typename read_t>
+[[nodiscard]] const res::optional_t<value_t>& memoize(
+  snapshot_t::readings_t<value_t>& readings,
+  const std::string& key,
+  read_t read) {
+    auto reading = readings.find(key);
+    if (reading == readings.end()) {
+        reading = readings.emplace(key, std::nullopt).first;
+    }
+    if (! reading->second.has_value()) {
+        reading->second.emplace(read());
+    }
+
+    return reading->second.value();
+}
+
+/**
+ * @brief Apply the --quantize and --hysteresis options of a field to its
+ * value.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] format_field - The field that expands the sub-format containing
+ * the field or sbar_field_none for a top-level field.
+ * @param[in] field - The field.
+ * @param[in] value - The value of the field.
+ * @param[in] device - The device that the value belongs to, if any.
+ */
+[[nodiscard]] double filter_value(persistent_state_t& persistent_state,
+  sbar_field_t format_field,
+  sbar_field_t field,
+  double value,
+  const std::string& device = {}) {
+    auto filter = persistent_state.value_filters.find({ format_field, field });
+    if (filter == persistent_state.value_filters.end()) {
+        return value;
+    }
+
+    return filter->second.apply(value, device);
+}
+
+/**
+ * @brief Get the partitions of a disk.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] disk - The disk.
+ */
+[[nodiscard]] const res::optional_t<std::vector<syst::part_t>>& get_parts(
+  persistent_state_t& persistent_state, const syst::disk_t& disk) {
+    return memoize(persistent_state.snapshot.parts,
+      disk.get_name(),
+      [&disk]() { return disk.get_parts(); });
+}
+
+/**
+ * @brief Get the mount info of a partition.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] part - The partition.
+ */
+[[nodiscard]] const res::optional_t<syst::mount_info_t>& get_mount_info(
+  persistent_state_t& persistent_state, const syst::part_t& part) {
+    return memoize(persistent_state.snapshot.mount_infos,
+      part.get_name(),
+      [&part]() { return part.get_mount_info(); });
+}
+
+/**
+ * @brief Get the packet and byte counters of a network interface.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] network_interface - The network interface.
+ */
+[[nodiscard]] const res::optional_t<syst::network_interface_t::stat_t>&
+get_network_stat(persistent_state_t& persistent_state,
+  const syst::network_interface_t& network_interface) {
+    return memoize(persistent_state.snapshot.network_stats,
+      network_interface.get_name(),
+      [&network_interface]() { return network_interface.get_stat(); });
+}
+
+const std::filesystem::path sysfs_block = "/sys/class/block";
+const std::filesystem::path sysfs_backlight = "/sys/class/backlight";
+const std::filesystem::path sysfs_power_supply = "/sys/class/power_supply";
+const std::filesystem::path sysfs_thermal = "/sys/class/thermal";
+
+[[nodiscard]] block_attributes_t make_block_attributes(
+  const std::string& name) {
+    auto device = sysfs_block / name;
+    return { device / "stat", device / "inflight" };
+}
+
+[[nodiscard]] backlight_attributes_t make_backlight_attributes(
+  const std::string& name) {
+    auto device = sysfs_backlight / name;
+    return { device / "brightness", device / "max_brightness" };
+}
+
+[[nodiscard]] battery_attributes_t make_battery_attributes(
+  const std::string& name) {
+    auto device = sysfs_power_supply / name;
+    return { device / "status", device / "capacity" };
+}
+
+/**
+ * @brief Find the sysfs attributes of a device. The attributes of every
+ * device are found when the devices are enumerated, so they are only made
+ * here for a device that appeared since.
+ *
+ * @param[in, out] attributes - The attributes of each device.
+ * @param[in] name - The name of the device.
+ * @param[in] make - Makes the attributes of a device from its name.
+ */
+template<typename attributes_t, typename make_t>
+[[nodiscard]] const attributes_t& find_attributes(
+  std::unordered_map<std::string, attributes_t>& attributes,
+  const std::string& name,
+  make_t make) {
+    auto device = attributes.find(name);
+    if (device == attributes.end()) {
+        device = attributes.emplace(name, make(name)).first;
+    }
 
-void signal_handler(int signal) {
-    keep_running = false;
+    return device->second;
 }
 
 /**
- * @brief Attempts to format a given string using std::sprintf.
- * Returns an error if the formatting fails.
+ * @brief Get the number of I/O requests in flight for a disk or partition.
  *
- * @tparam Args - The types of the arguments for formatting method.
- * @param[in] format - The string to be formatted.
- * @param[in] args - The arguments for the formatting method.
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] name - The name of the block device.
  */
-template<typename... args_t>
-[[nodiscard]] res::optional_t<std::string> sprintf(
-  const char* format, args_t... args) {
-    int size = std::snprintf(nullptr, 0, format, args...);
+[[nodiscard]] res::optional_t<unsigned long long> get_in_flight(
+  persistent_state_t& persistent_state, const std::string& name) {
+    // <reads> <writes>
+    const auto& attributes = find_attributes(
+      persistent_state.block_attributes, name, make_block_attributes);
+    auto& in_flight = persistent_state.block_attribute;
+    auto read_result =
+      persistent_state.sysfs_cache.read(attributes.in_flight, in_flight);
+    if (read_result.failure()) {
+        return RES_TRACE(read_result.error());
+    }
 
-    std::string buffer(size, '\0');
-    if (std::sprintf(buffer.data(), format, args...) < 0) {
+    unsigned long long reads = 0;
+    unsigned long long writes = 0;
+    if (std::sscanf(in_flight.c_str(), "%llu %llu", &reads, &writes) != 2) {
         return RES_NEW_ERROR(
-          std::string{ "Failed to format the given string.\n\tstring: " }
-          + format);
+          "Failed to parse the requests in flight of a block device: " + name);
     }
 
-    return buffer;
+    return reads + writes;
 }
 
-res::optional_t<std::string> add_storage_size_unit(uint64_t size) {
-    const uint64_t kibibyte = 1024;
-    const uint64_t mebibyte = kibibyte * 1024;
-    const uint64_t gibibyte = mebibyte * 1024;
-    const uint64_t tebibyte = gibibyte * 1024;
-    const uint64_t pebibyte = tebibyte * 1024;
+// Indices of the counters sampled for block_rates.
+enum block_rate_t : size_t {
+    block_rate_read_sectors,
+    block_rate_write_sectors,
+    block_rate_reads,
+    block_rate_writes,
+    block_rate_busy_ms,
+};
 
-    if (size > pebibyte) {
-        return sprintf("%iP", size / pebibyte);
+/**
+ * @brief Get the counters of a disk or partition that block_rates are
+ * derived from.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] name - The name of the block device.
+ */
+[[nodiscard]] res::optional_t<sbar::rate_tracker_t<5>::counters_t>
+get_block_counters(
+  persistent_state_t& persistent_state, const std::string& name) {
+    // <reads> <reads merged> <sectors read> <ms reading> <writes>
+    // <writes merged> <sectors written> <ms writing> <in flight>
+    // <ms doing I/O> ...
+    const auto& attributes = find_attributes(
+      persistent_state.block_attributes, name, make_block_attributes);
+    auto& stat = persistent_state.block_attribute;
+    auto read_result = persistent_state.sysfs_cache.read(attributes.stat, stat);
+    if (read_result.failure()) {
+        return RES_TRACE(read_result.error());
     }
-    if (size > tebibyte) {
-        return sprintf("%iT", size / tebibyte);
+
+    unsigned long long reads = 0;
+    unsigned long long read_sectors = 0;
+    unsigned long long writes = 0;
+    unsigned long long write_sectors = 0;
+    unsigned long long busy_ms = 0;
+    if (std::sscanf(stat.c_str(),
+          "%llu %*u %llu %*u %llu %*u %llu %*u %*u %llu",
+          &reads,
+          &read_sectors,
+          &writes,
+          &write_sectors,
+          &busy_ms)
+      != 5) {
+        return RES_NEW_ERROR(
+          "Failed to parse the statistics of a block device: " + name);
     }
-    if (size > gibibyte) {
-        return sprintf("%iG", size / gibibyte);
+
+    sbar::rate_tracker_t<5>::counters_t counters{};
+    counters.at(block_rate_read_sectors) = read_sectors;
+    counters.at(block_rate_write_sectors) = write_sectors;
+    counters.at(block_rate_reads) = reads;
+    counters.at(block_rate_writes) = writes;
+    counters.at(block_rate_busy_ms) = busy_ms;
+
+    return counters;
+}
+
+/**
+ * @brief Get the brightness of a backlight as a percentage.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] name - The name of the backlight.
+ */
+[[nodiscard]] res::optional_t<double> get_brightness(
+  persistent_state_t& persistent_state, const std::string& name) {
+    const auto& attributes = find_attributes(
+      persistent_state.backlight_attributes, name, make_backlight_attributes);
+
+    auto brightness =
+      persistent_state.sysfs_cache.read_integer(attributes.brightness);
+    if (brightness.has_error()) {
+        return RES_TRACE(brightness.error());
     }
-    if (size > mebibyte) {
-        return sprintf("%iM", size / mebibyte);
+
+    auto max_brightness =
+      persistent_state.sysfs_cache.read_integer(attributes.max_brightness);
+    if (max_brightness.has_error()) {
+        return RES_TRACE(max_brightness.error());
     }
-    if (size > kibibyte) {
-        return sprintf("%iK", size / kibibyte);
+    if (max_brightness.value() <= 0) {
+        return RES_NEW_ERROR(
+          "Invalid maximum brightness of a backlight: " + name);
     }
-    return sprintf("%i", size);
+
+    return 100 * static_cast<double>(brightness.value())
+      / static_cast<double>(max_brightness.value());
 }
 
-struct persistent_state_t {
-    // format strings
-    std::string status_fmt;
-    std::string disk_fmt;
-    std::string part_fmt;
-    std::string backlight_fmt;
-    std::string battery_fmt;
-    std::string network_fmt;
-    std::string audio_playback_fmt;
-    std::string audio_capture_fmt;
+/**
+ * @brief Get the status of a battery.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] name - The name of the battery.
+ */
+[[nodiscard]] res::optional_t<syst::battery_t::status_t> read_battery_status(
+  persistent_state_t& persistent_state, const std::string& name) {
+    const auto& attributes = find_attributes(
+      persistent_state.battery_attributes, name, make_battery_attributes);
+    auto& status = persistent_state.battery_attribute;
+    auto read_result =
+      persistent_state.sysfs_cache.read(attributes.status, status);
+    if (read_result.failure()) {
+        return RES_TRACE(read_result.error());
+    }
 
-    // options
-    bool ignore_zero_capacity_disks = true;
+    if (status == "Charging") {
+        return syst::battery_t::status_t::charging;
+    }
+    if (status == "Discharging") {
+        return syst::battery_t::status_t::discharging;
+    }
+    if (status == "Not charging") {
+        return syst::battery_t::status_t::not_charging;
+    }
+    if (status == "Full") {
+        return syst::battery_t::status_t::full;
+    }
+    return syst::battery_t::status_t::unknown;
+}
 
-    // persistent system_info structures
-    std::optional<syst::system_info_t> system_info;
-    std::unique_ptr<syst::sound_mixer_t> sound_mixer;
-    syst::cpu_usage_t cpu_usage;
+/**
+ * @brief Get the status of a battery.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] name - The name of the battery.
+ */
+[[nodiscard]] res::optional_t<syst::battery_t::status_t> get_battery_status(
+  persistent_state_t& persistent_state, const std::string& name) {
+    return memoize(persistent_state.snapshot.battery_statuses,
+      name,
+      [&]() { return read_battery_status(persistent_state, name); });
+}
 
-    // fields to update
-    sbar_field_t fields_to_update = sbar_field_all;
+/**
+ * @brief Get the charge of a battery as a percentage.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] battery - The battery.
+ */
+[[nodiscard]] res::optional_t<double> read_battery_charge(
+  persistent_state_t& persistent_state, const syst::battery_t& battery) {
+    const auto& attributes = find_attributes(persistent_state.battery_attributes,
+      battery.get_name(),
+      make_battery_attributes);
+
+    auto capacity =
+      persistent_state.sysfs_cache.read_integer(attributes.capacity);
+    if (capacity.has_error()) {
+        // Not every battery reports its charge as a percentage.
+        return battery.get_charge();
+    }
 
-    // saved field values
-    std::vector<std::string> fields =
-      std::vector<std::string>(sbar_total_fields);
-};
+    return static_cast<double>(capacity.value());
+}
+
+/**
+ * @brief Get the charge of a battery as a percentage.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] battery - The battery.
+ */
+[[nodiscard]] res::optional_t<double> get_battery_charge(
+  persistent_state_t& persistent_state, const syst::battery_t& battery) {
+    return memoize(persistent_state.snapshot.battery_charges,
+      battery.get_name(),
+      [&]() { return read_battery_charge(persistent_state, battery); });
+}
 
-using field_assigner_t = sbar_field_t (*)(char);
+/**
+ * @brief Read the temperature of a thermal zone in degrees Celsius.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] zone - The temperature attribute of the thermal zone.
+ */
+[[nodiscard]] res::optional_t<double> read_temperature(
+  persistent_state_t& persistent_state, const std::filesystem::path& zone) {
+    // millidegrees Celsius
+    auto temperature = persistent_state.sysfs_cache.read_integer(zone);
+    if (temperature.has_error()) {
+        return RES_TRACE(temperature.error());
+    }
+
+    const double millidegrees_per_degree = 1000;
+    return static_cast<double>(temperature.value()) / millidegrees_per_degree;
+}
+
+/**
+ * @brief Get the temperature of a thermal zone in degrees Celsius.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] zone - The temperature attribute of the thermal zone.
+ */
+[[nodiscard]] res::optional_t<double> get_temperature(
+  persistent_state_t& persistent_state, const std::filesystem::path& zone) {
+    return memoize(persistent_state.snapshot.temperatures,
+      zone.native(),
+      [&]() { return read_temperature(persistent_state, zone); });
+}
 
 template<typename... generator_args_t>
 using field_generator_t = res::optional_t<std::string> (*)(
   sbar_field_t, persistent_state_t&, generator_args_t...);
 
+/**
+ * @brief Append the status of a sub-format to the status of its parent so
+ * that no intermediate string is built.
+ *
+ * @param[in, out] status - The status to append to.
+ * @param[in] fmt - The compiled sub-format.
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] generator - Generates the fields of the sub-format.
+ * @param[in] generator_args - The device that the sub-format describes.
+ */
 template<typename... field_generator_args_t>
-[[nodiscard]] std::string make_given_status(const std::string& fmt,
-  bool top_level,
+void append_given_status(std::string& status,
+  const sbar::format_t& fmt,
   persistent_state_t& persistent_state,
-  field_assigner_t field_assigner,
   field_generator_t<const field_generator_args_t&...> generator,
   const field_generator_args_t&... generator_args) {
-    const char escape_seq = '/';
-
-    std::string status;
-
-    bool escaped = false;
-    for (char chr : fmt) {
-        if (! escaped) {
-            if (chr == escape_seq) {
-                escaped = true;
-            } else {
-                status += chr;
-            }
-            continue;
-        }
-
-        if (chr == escape_seq) {
-            status += chr;
+    for (const auto& segment : fmt.segments) {
+        if (segment.field == sbar_field_none) {
+            status.append(fmt.literals, segment.offset, segment.length);
             continue;
         }
 
-        escaped = false;
+        auto result = generator(segment.field,
+          std::forward<persistent_state_t&>(persistent_state),
+          std::forward<const field_generator_args_t&>(generator_args)...);
 
-        sbar_field_t field = field_assigner(chr);
-        if (field == sbar_field_none) {
-            std::cerr << "Invalid escaped token: '" << escape_seq << chr << "'"
-                      << std::endl;
-            continue;
+        if (result.has_value()) {
+            status += result.value();
+        } else {
+            status += error_status;
+            std::cerr << result.error() << std::endl;
         }
+    }
+}
 
-        size_t field_index = __builtin_ctzll(field);
+template<typename... appender_args_t>
+using field_appender_t = res::result_t (*)(
+  std::string&, sbar_field_t, persistent_state_t&, appender_args_t...);
 
-        if ((field & persistent_state.fields_to_update) == sbar_field_none) {
-            if (top_level) {
-                status += persistent_state.fields.at(field_index);
-            }
+/**
+ * @brief Append the status of a sub-format to the status of its parent with
+ * a generator that appends each field in place.
+ *
+ * @param[in, out] status - The status to append to.
+ * @param[in] fmt - The compiled sub-format.
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] appender - Appends the fields of the sub-format.
+ * @param[in] appender_args - The device that the sub-format describes.
+ */
+template<typename... field_appender_args_t>
+void append_given_status(std::string& status,
+  const sbar::format_t& fmt,
+  persistent_state_t& persistent_state,
+  field_appender_t<const field_appender_args_t&...> appender,
+  const field_appender_args_t&... appender_args) {
+    for (const auto& segment : fmt.segments) {
+        if (segment.field == sbar_field_none) {
+            status.append(fmt.literals, segment.offset, segment.length);
             continue;
         }
 
-        auto result = generator(field,
-          std::forward<persistent_state_t&>(persistent_state),
-          std::forward<const field_generator_args_t&>(generator_args)...);
+        auto length = status.size();
+        auto result =
+          appender(status, segment.field, persistent_state, appender_args...);
 
-        std::string status_part;
-        if (result.has_value()) {
-            status_part = result.value();
-        } else {
-            status_part = error_status;
+        if (result.failure()) {
+            // Discard anything appended before the failure.
+            status.resize(length);
+            status += error_status;
             std::cerr << result.error() << std::endl;
         }
+    }
+}
 
-        if (top_level) {
-            persistent_state.fields.at(field_index) = status_part;
-        }
-        status += status_part;
+// Fields of --disk-status and --partition-status beyond the bits of
+// sbar_field_t.
+constexpr sbar_field_t block_field_read_rate = sbar::make_extended_field(1);
+constexpr sbar_field_t block_field_write_rate = sbar::make_extended_field(2);
+constexpr sbar_field_t block_field_iops = sbar::make_extended_field(3);
+constexpr sbar_field_t block_field_utilization = sbar::make_extended_field(4);
+
+[[nodiscard]] res::result_t block_rate_field_appender(std::string& output,
+  sbar_field_t field,
+  persistent_state_t& persistent_state,
+  sbar_field_t format_field,
+  const std::string& name) {
+    // Sectors are always 512 bytes in the statistics of a block device.
+    const double sector_size = 512;
+
+    // Rates are zero until the device has been sampled twice.
+    auto rates = persistent_state.block_rates.get_rates(name).value_or(
+      sbar::rate_tracker_t<5>::rates_t{});
+
+    auto filter = [&](double value) {
+        return filter_value(persistent_state, format_field, field, value, name);
+    };
+
+    if (field == block_field_read_rate) {
+        auto bytes = rates.at(block_rate_read_sectors) * sector_size;
+        sbar::append_storage_size(
+          output, static_cast<uint64_t>(filter(bytes)));
+        return res::success;
+    }
+    if (field == block_field_write_rate) {
+        auto bytes = rates.at(block_rate_write_sectors) * sector_size;
+        sbar::append_storage_size(
+          output, static_cast<uint64_t>(filter(bytes)));
+        return res::success;
+    }
+    if (field == block_field_iops) {
+        sbar::append_fixed(output,
+          filter(rates.at(block_rate_reads) + rates.at(block_rate_writes)),
+          0);
+        return res::success;
+    }
+    if (field == block_field_utilization) {
+        // Milliseconds spent doing I/O per second of wall time.
+        auto utilization = rates.at(block_rate_busy_ms) / 10;
+        sbar::append_fixed(output, filter(std::min(utilization, 100.0)), 0);
+        return res::success;
     }
 
-    return status;
+    return RES_NEW_ERROR("Invalid field value: " + std::to_string(field));
 }
 
 [[nodiscard]] sbar_field_t part_field_assigner(char token) {
@@ -193,18 +726,32 @@ template<typename... field_generator_args_t>
             return sbar_field_part_usage;
         case 'F':
             return sbar_field_part_in_flight;
+        case 'r':
+            return block_field_read_rate;
+        case 'w':
+            return block_field_write_rate;
+        case 'I':
+            return block_field_iops;
+        case 'B':
+            return block_field_utilization;
         default:
             return sbar_field_none;
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> part_field_generator(
+[[nodiscard]] res::result_t part_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
   const syst::part_t& part) {
+    if ((field & sbar::extended_field) != 0) {
+        return block_rate_field_appender(
+          output, field, persistent_state, sbar_field_part, part.get_name());
+    }
+
     switch (field) {
         case sbar_field_part_name: {
-            return part.get_name();
+            output += part.get_name();
+            return res::success;
         }
         case sbar_field_part_read_only: {
             auto read_only = part.is_read_only();
@@ -213,26 +760,30 @@ template<typename... field_generator_args_t>
             }
 
             if (read_only.value()) {
-                return std::string{ "\U0001F441" }; // 👁️
+                output += "\U0001F441"; // 👁️
+                return res::success;
             }
 
-            return std::string{ "\U0000270F" }; // ✏️
+            output += "\U0000270F"; // ✏️
+            return res::success;
         }
         case sbar_field_part_mount: {
-            auto mount_info = part.get_mount_info();
+            const auto& mount_info = get_mount_info(persistent_state, part);
             if (! mount_info.has_value()) {
                 return RES_TRACE(mount_info.error());
             }
 
-            return mount_info->mount_path.string();
+            output += mount_info->mount_path.native();
+            return res::success;
         }
         case sbar_field_part_filesystem: {
-            auto mount_info = part.get_mount_info();
+            const auto& mount_info = get_mount_info(persistent_state, part);
             if (! mount_info.has_value()) {
                 return RES_TRACE(mount_info.error());
             }
 
-            return mount_info->fs_type;
+            output += mount_info->fs_type;
+            return res::success;
         }
         case sbar_field_part_size: {
             auto size = part.get_size();
@@ -240,29 +791,36 @@ template<typename... field_generator_args_t>
                 return RES_TRACE(size.error());
             }
 
-            return add_storage_size_unit(size.value());
+            sbar::append_storage_size(output, size.value());
+            return res::success;
         }
         case sbar_field_part_usage: {
-            auto mount_info = part.get_mount_info();
+            const auto& mount_info = get_mount_info(persistent_state, part);
             if (! mount_info.has_value()) {
                 return RES_TRACE(mount_info.error());
             }
 
-            auto space_info = std::filesystem::space(mount_info->mount_path);
+            auto space_info = persistent_state.mount_prober.get_space(
+              mount_info->mount_path, persistent_state.mount_timeout);
+            if (space_info.has_error()) {
+                return RES_TRACE(space_info.error());
+            }
 
-            auto available = static_cast<double>(space_info.available);
-            auto capacity = static_cast<double>(space_info.capacity);
+            auto available = static_cast<double>(space_info->available);
+            auto capacity = static_cast<double>(space_info->capacity);
             auto used = 100 * (1 - (available / capacity));
 
-            return sprintf("%.0f", used);
+            sbar::append_fixed(output, used, 0);
+            return res::success;
         }
         case sbar_field_part_in_flight: {
-            auto io_stat = part.get_io_stat();
-            if (! io_stat.has_value()) {
-                return RES_TRACE(io_stat.error());
+            auto in_flight = get_in_flight(persistent_state, part.get_name());
+            if (! in_flight.has_value()) {
+                return RES_TRACE(in_flight.error());
             }
 
-            return sprintf("%i", io_stat->io_in_flight);
+            sbar::append_integer(output, in_flight.value());
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -284,6 +842,14 @@ template<typename... field_generator_args_t>
             return sbar_field_disk_size;
         case 'F':
             return sbar_field_disk_in_flight;
+        case 'r':
+            return block_field_read_rate;
+        case 'w':
+            return block_field_write_rate;
+        case 'I':
+            return block_field_iops;
+        case 'B':
+            return block_field_utilization;
         case 'P':
             return sbar_field_part;
         default:
@@ -291,13 +857,19 @@ template<typename... field_generator_args_t>
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> disk_field_generator(
+[[nodiscard]] res::result_t disk_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
   const syst::disk_t& disk) {
+    if ((field & sbar::extended_field) != 0) {
+        return block_rate_field_appender(
+          output, field, persistent_state, sbar_field_disk, disk.get_name());
+    }
+
     switch (field) {
         case sbar_field_disk_name: {
-            return disk.get_name();
+            output += disk.get_name();
+            return res::success;
         }
         case sbar_field_disk_rotational: {
             auto rotational = disk.is_rotational();
@@ -306,10 +878,12 @@ template<typename... field_generator_args_t>
             }
 
             if (rotational.value()) {
-                return std::string{ "💿" };
+                output += "💿";
+                return res::success;
             }
 
-            return std::string{ "💾" };
+            output += "💾";
+            return res::success;
         }
         case sbar_field_disk_read_only: {
             auto read_only = disk.is_read_only();
@@ -318,10 +892,12 @@ template<typename... field_generator_args_t>
             }
 
             if (read_only.value()) {
-                return std::string{ "\U0001F441" }; // 👁️
+                output += "\U0001F441"; // 👁️
+                return res::success;
             }
 
-            return std::string{ "\U0000270F" }; // ✏️
+            output += "\U0000270F"; // ✏️
+            return res::success;
         }
         case sbar_field_disk_removable: {
             auto removable = disk.is_removable();
@@ -330,10 +906,10 @@ template<typename... field_generator_args_t>
             }
 
             if (removable.value()) {
-                return std::string{ "🔌" };
+                output += "🔌";
             }
 
-            return std::string{ "" };
+            return res::success;
         }
         case sbar_field_disk_size: {
             auto size = disk.get_size();
@@ -341,34 +917,32 @@ template<typename... field_generator_args_t>
                 return RES_TRACE(size.error());
             }
 
-            return add_storage_size_unit(size.value());
+            sbar::append_storage_size(output, size.value());
+            return res::success;
         }
         case sbar_field_disk_in_flight: {
-            auto io_stat = disk.get_io_stat();
-            if (! io_stat.has_value()) {
-                return RES_TRACE(io_stat.error());
+            auto in_flight = get_in_flight(persistent_state, disk.get_name());
+            if (! in_flight.has_value()) {
+                return RES_TRACE(in_flight.error());
             }
 
-            return sprintf("%i", io_stat->io_in_flight);
+            sbar::append_integer(output, in_flight.value());
+            return res::success;
         }
         case sbar_field_part: {
-            auto parts = disk.get_parts();
+            const auto& parts = get_parts(persistent_state, disk);
             if (parts.has_error()) {
                 return RES_TRACE(parts.error());
             }
 
-            std::string status;
-
             for (const auto& part : parts.value()) {
-                status += make_given_status(persistent_state.part_fmt,
-                  false,
+                append_given_status(output, persistent_state.part_fmt,
                   persistent_state,
-                  part_field_assigner,
-                  part_field_generator,
+                  part_field_appender,
                   part);
             }
 
-            return status;
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -387,20 +961,24 @@ template<typename... field_generator_args_t>
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> backlight_field_generator(
+[[nodiscard]] res::result_t backlight_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
   const syst::backlight_t& backlight) {
     switch (field) {
         case sbar_field_backlight_name: {
-            return backlight.get_name();
+            output += backlight.get_name();
+            return res::success;
         }
         case sbar_field_backlight_brightness: {
-            auto brightness = backlight.get_brightness();
+            auto brightness =
+              get_brightness(persistent_state, backlight.get_name());
             if (brightness.has_error()) {
                 return RES_TRACE(brightness.error());
             }
-            return sprintf("%i", static_cast<int>(brightness.value()));
+            sbar::append_integer(
+              output, static_cast<int>(brightness.value()));
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -429,33 +1007,37 @@ template<typename... field_generator_args_t>
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> battery_field_generator(
+[[nodiscard]] res::result_t battery_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
   const syst::battery_t& battery) {
     switch (field) {
         case sbar_field_battery_name: {
-            return battery.get_name();
+            output += battery.get_name();
+            return res::success;
         }
         case sbar_field_battery_status: {
-            auto status = battery.get_status();
+            auto status =
+              get_battery_status(persistent_state, battery.get_name());
             if (status.has_error()) {
                 return RES_TRACE(status.error());
             }
 
             if (status.value() == syst::battery_t::status_t::full
               || status.value() == syst::battery_t::status_t::charging) {
-                return std::string{ "🟢" };
+                output += "🟢";
+                return res::success;
             }
             if (status.value() == syst::battery_t::status_t::not_charging) {
-                return std::string{ "⭕" };
+                output += "⭕";
+                return res::success;
             }
             if (status.value() != syst::battery_t::status_t::discharging) {
                 return RES_NEW_ERROR("Unknown battery status code: "
                   + std::to_string(static_cast<int>(status.value())));
             }
 
-            auto charge = battery.get_charge();
+            auto charge = get_battery_charge(persistent_state, battery);
             if (charge.has_error()) {
                 return RES_TRACE(charge.error());
             }
@@ -465,53 +1047,69 @@ template<typename... field_generator_args_t>
             const double medium_charge = 60;
 
             if (charge.value() <= very_low_charge) {
-                return std::string{ "🔴" };
+                output += "🔴";
+                return res::success;
             }
             if (charge.value() <= low_charge) {
-                return std::string{ "🟠" };
+                output += "🟠";
+                return res::success;
             }
             if (charge.value() <= medium_charge) {
-                return std::string{ "🟡" };
+                output += "🟡";
+                return res::success;
             }
-            return std::string{ "🔵" };
+            output += "🔵";
+            return res::success;
         }
         case sbar_field_battery_charge: {
-            auto charge = battery.get_charge();
+            auto charge = get_battery_charge(persistent_state, battery);
             if (charge.has_error()) {
                 return RES_TRACE(charge.error());
             }
-            return sprintf("%i", static_cast<int>(charge.value()));
+            sbar::append_integer(output,
+              static_cast<int>(filter_value(persistent_state,
+                sbar_field_battery, field, charge.value(),
+                battery.get_name())));
+            return res::success;
         }
         case sbar_field_battery_capacity: {
             auto capacity = battery.get_capacity();
             if (capacity.has_error()) {
                 return RES_TRACE(capacity.error());
             }
-            return sprintf("%f", capacity.value());
+            sbar::append_fixed(output, capacity.value(), 6);
+            return res::success;
         }
         case sbar_field_battery_current: {
             auto current = battery.get_current();
             if (current.has_error()) {
                 return RES_TRACE(current.error());
             }
-            return sprintf("%f", current.value());
+            sbar::append_fixed(output, current.value(), 6);
+            return res::success;
         }
         case sbar_field_battery_power: {
             auto power = battery.get_power();
             if (power.has_error()) {
                 return RES_TRACE(power.error());
             }
-            return sprintf("%f", power.value());
+            sbar::append_fixed(output,
+              filter_value(persistent_state, sbar_field_battery, field,
+                power.value(), battery.get_name()),
+              6);
+            return res::success;
         }
         case sbar_field_battery_time: {
-            auto status = battery.get_status();
+            auto status =
+              get_battery_status(persistent_state, battery.get_name());
             if (status.has_error()) {
                 return RES_TRACE(status.error());
             }
 
             if (status.value() != syst::battery_t::status_t::charging
               && status.value() != syst::battery_t::status_t::discharging) {
-                return std::string{ "⭕" };
+                output += "⭕";
+                return res::success;
             }
 
             auto seconds = battery.get_time_remaining();
@@ -522,7 +1120,10 @@ template<typename... field_generator_args_t>
             auto hours = seconds.value().count() / 3600;
             auto minutes = (seconds.value().count() % 3600) / 60;
 
-            return sprintf("%i:%.2i", hours, minutes);
+            sbar::append_integer(output, hours);
+            output += ':';
+            sbar::append_integer(output, minutes, 2);
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -530,6 +1131,24 @@ template<typename... field_generator_args_t>
     }
 }
 
+// Fields of --network-status beyond the bits of sbar_field_t.
+constexpr sbar_field_t network_field_bytes_down_rate =
+  sbar::make_extended_field(1);
+constexpr sbar_field_t network_field_bytes_up_rate =
+  sbar::make_extended_field(2);
+constexpr sbar_field_t network_field_packets_down_rate =
+  sbar::make_extended_field(3);
+constexpr sbar_field_t network_field_packets_up_rate =
+  sbar::make_extended_field(4);
+
+// Indices of the counters sampled for network_rates.
+enum network_rate_t : size_t {
+    network_rate_bytes_down,
+    network_rate_bytes_up,
+    network_rate_packets_down,
+    network_rate_packets_up,
+};
+
 [[nodiscard]] sbar_field_t network_field_assigner(char token) {
     switch (token) {
         case 'N':
@@ -544,66 +1163,161 @@ template<typename... field_generator_args_t>
             return sbar_field_network_bytes_down;
         case 't':
             return sbar_field_network_bytes_up;
+        case 'd':
+            return network_field_bytes_down_rate;
+        case 'u':
+            return network_field_bytes_up_rate;
+        case 'D':
+            return network_field_packets_down_rate;
+        case 'U':
+            return network_field_packets_up_rate;
         default:
             return sbar_field_none;
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> network_field_generator(
+[[nodiscard]] res::result_t network_rate_field_appender(std::string& output,
+  sbar_field_t field,
+  persistent_state_t& persistent_state,
+  const syst::network_interface_t& network_interface) {
+    // Rates are zero until the interface has been sampled twice.
+    auto rates =
+      persistent_state.network_rates.get_rates(network_interface.get_name())
+        .value_or(sbar::rate_tracker_t<4>::rates_t{});
+
+    auto filter = [&](double value) {
+        return filter_value(persistent_state, sbar_field_network, field, value,
+          network_interface.get_name());
+    };
+
+    if (field == network_field_bytes_down_rate) {
+        sbar::append_storage_size(output,
+          static_cast<uint64_t>(filter(rates.at(network_rate_bytes_down))));
+        return res::success;
+    }
+    if (field == network_field_bytes_up_rate) {
+        sbar::append_storage_size(output,
+          static_cast<uint64_t>(filter(rates.at(network_rate_bytes_up))));
+        return res::success;
+    }
+    if (field == network_field_packets_down_rate) {
+        sbar::append_fixed(
+          output, filter(rates.at(network_rate_packets_down)), 0);
+        return res::success;
+    }
+    if (field == network_field_packets_up_rate) {
+        sbar::append_fixed(output, filter(rates.at(network_rate_packets_up)), 0);
+        return res::success;
+    }
+
+    return RES_NEW_ERROR("Invalid field value: " + std::to_string(field));
+}
+
+/**
+ * @brief Append a field of --network-status to the status. The counters are
+ * formatted in place because they are often too long to fit within a string
+ * without allocating.
+ *
+ * @param[in, out] output - The status to append to.
+ * @param[in] field - The field to append.
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] network_interface - The network interface.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t network_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
   const syst::network_interface_t& network_interface) {
+    if ((field & sbar::extended_field) != 0) {
+        return network_rate_field_appender(
+          output, field, persistent_state, network_interface);
+    }
+
     switch (field) {
         case sbar_field_network_name: {
-            return network_interface.get_name();
+            output += network_interface.get_name();
+            return res::success;
         }
         case sbar_field_network_status: {
+            using link_state_t = sbar::network_monitor_t::link_state_t;
+
+            // Prefer the state reported by the kernel over reading sysfs.
+            const auto* network_monitor =
+              persistent_state.network_monitor.load();
+            if (network_monitor != nullptr) {
+                auto state =
+                  network_monitor->get_link_state(network_interface.get_name());
+                if (state == link_state_t::up) {
+                    output += "🟢";
+                    return res::success;
+                }
+                if (state == link_state_t::dormant) {
+                    output += "🟡";
+                    return res::success;
+                }
+                if (state == link_state_t::down) {
+                    output += "🔴";
+                    return res::success;
+                }
+            }
+
             auto status = network_interface.get_status();
             if (status.has_error()) {
                 return RES_TRACE(status.error());
             }
 
             if (status.value() == syst::network_interface_t::status_t::up) {
-                return std::string{ "🟢" };
+                output += "🟢";
+                return res::success;
             }
             if (status.value()
               == syst::network_interface_t::status_t::dormant) {
-                return std::string{ "🟡" };
+                output += "🟡";
+                return res::success;
             }
             if (status.value() == syst::network_interface_t::status_t::down) {
-                return std::string{ "🔴" };
+                output += "🔴";
+                return res::success;
             }
 
             return RES_NEW_ERROR("Unknown network interface status code: "
               + std::to_string(static_cast<int>(status.value())));
         }
         case sbar_field_network_packets_down: {
-            auto stat = network_interface.get_stat();
+            const auto& stat =
+              get_network_stat(persistent_state, network_interface);
             if (stat.has_error()) {
                 return RES_TRACE(stat.error());
             }
-            return std::to_string(stat->packets_down);
+            sbar::append_integer(output, stat->packets_down);
+            return res::success;
         }
         case sbar_field_network_packets_up: {
-            auto stat = network_interface.get_stat();
+            const auto& stat =
+              get_network_stat(persistent_state, network_interface);
             if (stat.has_error()) {
                 return RES_TRACE(stat.error());
             }
-            return std::to_string(stat->packets_up);
+            sbar::append_integer(output, stat->packets_up);
+            return res::success;
         }
         case sbar_field_network_bytes_down: {
-            auto stat = network_interface.get_stat();
+            const auto& stat =
+              get_network_stat(persistent_state, network_interface);
             if (stat.has_error()) {
                 return RES_TRACE(stat.error());
             }
-            return std::to_string(stat->bytes_down);
+            sbar::append_integer(output, stat->bytes_down);
+            return res::success;
         }
         case sbar_field_network_bytes_up: {
-            auto stat = network_interface.get_stat();
+            const auto& stat =
+              get_network_stat(persistent_state, network_interface);
             if (stat.has_error()) {
                 return RES_TRACE(stat.error());
             }
-            return std::to_string(stat->bytes_up);
+            sbar::append_integer(output, stat->bytes_up);
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -611,7 +1325,7 @@ template<typename... field_generator_args_t>
     }
 }
 
-[[nodiscard]] std::string audio_channel_status_to_string(bool status) {
+[[nodiscard]] const char* audio_channel_status_to_string(bool status) {
     if (status) {
         return "🟢";
     }
@@ -619,13 +1333,13 @@ template<typename... field_generator_args_t>
     return "🔴";
 }
 
-[[nodiscard]] std::string make_audio_channel_status(
+void append_audio_channel_status(std::string& output,
   const std::optional<bool>& status,
-  const std::string& label,
+  const char* label,
   std::optional<bool>& first_value,
   bool& all_values_match) {
     if (! status.has_value()) {
-        return "";
+        return;
     }
 
     if (first_value.has_value()) {
@@ -636,25 +1350,18 @@ template<typename... field_generator_args_t>
         first_value = status;
     }
 
-    return audio_channel_status_to_string(status.value()) + label + ' ';
+    output += audio_channel_status_to_string(status.value());
+    output += label;
+    output += ' ';
 }
 
-[[nodiscard]] std::string audio_channel_volume_to_string(double status) {
-    auto result = sprintf("%i", static_cast<int>(status));
-    if (result.has_error()) {
-        std::cerr << RES_TRACE(result.error()) << std::endl;
-        return error_status;
-    }
-    return result.value();
-}
-
-[[nodiscard]] std::string make_audio_channel_volume(
+void append_audio_channel_volume(std::string& output,
   const std::optional<double>& volume,
-  const std::string& label,
+  const char* label,
   std::optional<double>& first_value,
   bool& all_values_match) {
     if (! volume.has_value()) {
-        return "";
+        return;
     }
 
     if (first_value.has_value()) {
@@ -665,7 +1372,9 @@ template<typename... field_generator_args_t>
         first_value = volume;
     }
 
-    return audio_channel_volume_to_string(volume.value()) + label + ' ';
+    sbar::append_integer(output, static_cast<int>(volume.value()));
+    output += label;
+    output += ' ';
 }
 
 [[nodiscard]] sbar_field_t audio_playback_field_assigner(char token) {
@@ -681,111 +1390,110 @@ template<typename... field_generator_args_t>
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> audio_playback_field_generator(
+[[nodiscard]] res::result_t audio_playback_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
-  const syst::sound_control_t& sound_control) {
+  const sbar::audio_monitor_t::control_t& audio_control) {
     switch (field) {
         case sbar_field_audio_playback_name: {
-            return sound_control.get_name();
+            output += audio_control.name;
+            return res::success;
         }
         case sbar_field_audio_playback_status: {
-            if (! sound_control.has_playback_status()) {
+            if (! audio_control.playback_status.has_value()) {
                 return RES_NEW_ERROR("This audio control does not have a "
                                      "playback status.\n\tname: "
-                  + sound_control.get_name());
+                  + audio_control.name);
             }
 
-            auto playback_status = sound_control.get_playback_status();
-            if (playback_status.has_error()) {
-                return RES_TRACE(playback_status.error());
-            }
+            const auto& playback_status = audio_control.playback_status.value();
 
-            std::string status;
+            auto start = output.size();
             std::optional<bool> first;
             bool all_match = true;
 
-            status += '(';
-
-            status += make_audio_channel_status(
-              playback_status->front_left, "fl", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->front_center, "fc", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->front_right, "fr", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->side_left, "sl", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->woofer, "w", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->side_right, "sr", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->rear_left, "rl", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->rear_center, "rc", first, all_match);
-            status += make_audio_channel_status(
-              playback_status->rear_right, "rr", first, all_match);
+            output += '(';
+
+            append_audio_channel_status(output,
+              playback_status.front_left, "fl", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.front_center, "fc", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.front_right, "fr", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.side_left, "sl", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.woofer, "w", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.side_right, "sr", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.rear_left, "rl", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.rear_center, "rc", first, all_match);
+            append_audio_channel_status(output,
+              playback_status.rear_right, "rr", first, all_match);
 
             if (! first.has_value()) {
-                return std::string{};
+                output.resize(start);
+                return res::success;
             }
 
             if (all_match) {
-                return audio_channel_status_to_string(first.value());
+                output.resize(start);
+                output += audio_channel_status_to_string(first.value());
+                return res::success;
             }
 
-            status.back() = ')';
-
-            return status;
+            output.back() = ')';
+            return res::success;
         }
         case sbar_field_audio_playback_volume: {
-            if (! sound_control.has_playback_volume()) {
+            if (! audio_control.playback_volume.has_value()) {
                 return RES_NEW_ERROR("This audio control does not have a "
                                      "playback volume.\n\tname: "
-                  + sound_control.get_name());
+                  + audio_control.name);
             }
 
-            auto playback_volume = sound_control.get_playback_volume();
-            if (playback_volume.has_error()) {
-                return RES_TRACE(playback_volume.error());
-            }
+            const auto& playback_volume = audio_control.playback_volume.value();
 
-            std::string status;
+            auto start = output.size();
             std::optional<double> first;
             bool all_match = true;
 
-            status += '(';
-
-            status += make_audio_channel_volume(
-              playback_volume->front_left, "fl", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->front_center, "fc", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->front_right, "fr", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->side_left, "sl", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->woofer, "w", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->side_right, "sr", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->rear_left, "rl", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->rear_center, "rc", first, all_match);
-            status += make_audio_channel_volume(
-              playback_volume->rear_right, "rr", first, all_match);
+            output += '(';
+
+            append_audio_channel_volume(output,
+              playback_volume.front_left, "fl", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.front_center, "fc", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.front_right, "fr", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.side_left, "sl", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.woofer, "w", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.side_right, "sr", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.rear_left, "rl", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.rear_center, "rc", first, all_match);
+            append_audio_channel_volume(output,
+              playback_volume.rear_right, "rr", first, all_match);
 
             if (! first.has_value()) {
-                return std::string{};
+                output.resize(start);
+                return res::success;
             }
 
             if (all_match) {
-                return audio_channel_volume_to_string(first.value());
+                output.resize(start);
+                sbar::append_integer(output, static_cast<int>(first.value()));
+                return res::success;
             }
 
-            status.back() = ')';
-
-            return status;
+            output.back() = ')';
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -806,111 +1514,110 @@ template<typename... field_generator_args_t>
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> audio_capture_field_generator(
+[[nodiscard]] res::result_t audio_capture_field_appender(std::string& output,
   sbar_field_t field,
   persistent_state_t& persistent_state,
-  const syst::sound_control_t& sound_control) {
+  const sbar::audio_monitor_t::control_t& audio_control) {
     switch (field) {
         case sbar_field_audio_capture_name: {
-            return sound_control.get_name();
+            output += audio_control.name;
+            return res::success;
         }
         case sbar_field_audio_capture_status: {
-            if (! sound_control.has_capture_status()) {
+            if (! audio_control.capture_status.has_value()) {
                 return RES_NEW_ERROR("This audio control does not have a "
                                      "capture status.\n\tname: "
-                  + sound_control.get_name());
+                  + audio_control.name);
             }
 
-            auto capture_status = sound_control.get_capture_status();
-            if (capture_status.has_error()) {
-                return RES_TRACE(capture_status.error());
-            }
+            const auto& capture_status = audio_control.capture_status.value();
 
-            std::string status;
+            auto start = output.size();
             std::optional<bool> first;
             bool all_match = true;
 
-            status += '(';
-
-            status += make_audio_channel_status(
-              capture_status->front_left, "fl", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->front_center, "fc", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->front_right, "fr", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->side_left, "sl", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->woofer, "w", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->side_right, "sr", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->rear_left, "rl", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->rear_center, "rc", first, all_match);
-            status += make_audio_channel_status(
-              capture_status->rear_right, "rr", first, all_match);
+            output += '(';
+
+            append_audio_channel_status(output,
+              capture_status.front_left, "fl", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.front_center, "fc", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.front_right, "fr", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.side_left, "sl", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.woofer, "w", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.side_right, "sr", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.rear_left, "rl", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.rear_center, "rc", first, all_match);
+            append_audio_channel_status(output,
+              capture_status.rear_right, "rr", first, all_match);
 
             if (! first.has_value()) {
-                return std::string{};
+                output.resize(start);
+                return res::success;
             }
 
             if (all_match) {
-                return audio_channel_status_to_string(first.value());
+                output.resize(start);
+                output += audio_channel_status_to_string(first.value());
+                return res::success;
             }
 
-            status.back() = ')';
-
-            return status;
+            output.back() = ')';
+            return res::success;
         }
         case sbar_field_audio_capture_volume: {
-            if (! sound_control.has_capture_volume()) {
+            if (! audio_control.capture_volume.has_value()) {
                 return RES_NEW_ERROR("This audio control does not have a "
                                      "capture volume.\n\tname: "
-                  + sound_control.get_name());
+                  + audio_control.name);
             }
 
-            auto capture_volume = sound_control.get_capture_volume();
-            if (capture_volume.has_error()) {
-                return RES_TRACE(capture_volume.error());
-            }
+            const auto& capture_volume = audio_control.capture_volume.value();
 
-            std::string status;
+            auto start = output.size();
             std::optional<double> first;
             bool all_match = true;
 
-            status += '(';
-
-            status += make_audio_channel_volume(
-              capture_volume->front_left, "fl", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->front_center, "fc", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->front_right, "fr", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->side_left, "sl", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->woofer, "w", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->side_right, "sr", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->rear_left, "rl", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->rear_center, "rc", first, all_match);
-            status += make_audio_channel_volume(
-              capture_volume->rear_right, "rr", first, all_match);
+            output += '(';
+
+            append_audio_channel_volume(output,
+              capture_volume.front_left, "fl", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.front_center, "fc", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.front_right, "fr", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.side_left, "sl", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.woofer, "w", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.side_right, "sr", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.rear_left, "rl", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.rear_center, "rc", first, all_match);
+            append_audio_channel_volume(output,
+              capture_volume.rear_right, "rr", first, all_match);
 
             if (! first.has_value()) {
-                return std::string{};
+                output.resize(start);
+                return res::success;
             }
 
             if (all_match) {
-                return audio_channel_volume_to_string(first.value());
+                output.resize(start);
+                sbar::append_integer(output, static_cast<int>(first.value()));
+                return res::success;
             }
 
-            status.back() = ')';
-
-            return status;
+            output.back() = ')';
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -960,55 +1667,164 @@ template<typename... field_generator_args_t>
             return sbar_field_kernel;
         case 'k':
             return sbar_field_outdated_kernel;
+        case 'x':
+            return sbar_field_context_switches;
+        case 'i':
+            return sbar_field_interrupts;
+        case 'r':
+            return sbar_field_procs_running;
+        case 'a':
+            return sbar_field_memory_available;
+        case 'c':
+            return sbar_field_memory_cached;
+        case 'd':
+            return sbar_field_memory_dirty;
+        default:
+            return sbar_field_none;
+    }
+}
+
+[[nodiscard]] sbar_field_t history_field_assigner(char token) {
+    switch (token) {
+        case 'W':
+            return sbar_field_cpu;
+        case 'M':
+            return sbar_field_memory;
+        case 'H':
+            return sbar_field_highest_temp;
+        case 'N':
+            return sbar_field_network;
         default:
             return sbar_field_none;
     }
 }
 
-[[nodiscard]] res::optional_t<std::string> status_field_generator(
-  sbar_field_t field, persistent_state_t& persistent_state) {
+/**
+ * @brief Get the metric recorded for the history of a field.
+ *
+ * @param[in] field - A field returned by history_field_assigner.
+ */
+[[nodiscard]] std::optional<history_metric_t> get_history_metric(
+  sbar_field_t field) {
     switch (field) {
-        case sbar_field_time: {
-            std::time_t epoch_time = std::time(nullptr);
-            std::tm* calendar_time = std::localtime(&epoch_time);
+        case sbar_field_cpu:
+            return history_cpu;
+        case sbar_field_memory:
+            return history_memory;
+        case sbar_field_highest_temp:
+            return history_highest_temp;
+        case sbar_field_network:
+            return history_network;
+        default:
+            return std::nullopt;
+    }
+}
 
-            // RFC 3339 format
-            return sprintf("%i-%.2i-%.2i %.2i:%.2i:%.2i",
-              calendar_time->tm_year + 1900,
-              calendar_time->tm_mon + 1,
-              calendar_time->tm_mday,
-              calendar_time->tm_hour,
-              calendar_time->tm_min,
-              calendar_time->tm_sec);
-        }
-        case sbar_field_uptime: {
-            if (! persistent_state.system_info.has_value()) {
-                return RES_NEW_ERROR(
-                  "Failed to get the uptime due to a "
+/**
+ * @brief Get the highest temperature of every thermal zone.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ */
+[[nodiscard]] res::optional_t<double> get_highest_temperature(
+  persistent_state_t& persistent_state) {
+    if (! persistent_state.thermal_zones.has_value()) {
+        return RES_NEW_ERROR(
+          "Failed to get the highest temperature measurement due to a "
+          "previous failure to get the thermal zones.");
+    }
+
+    std::optional<double> highest_temp;
+
+    for (const auto& zone : persistent_state.thermal_zones.value()) {
+        auto temp = get_temperature(persistent_state, zone);
+        if (temp.has_error()) {
+            return RES_TRACE(temp.error());
+        }
+
+        if (! highest_temp.has_value()) {
+            highest_temp = temp.value();
+            continue;
+        }
+
+        if (temp.value() > highest_temp) {
+            highest_temp = temp.value();
+        }
+    }
+
+    if (! highest_temp.has_value()) {
+        return RES_NEW_ERROR(
+          "Failed to get the highest temperature measurement due to a "
+          "lack of any thermal measurements.");
+    }
+
+    return highest_temp.value();
+}
+
+/**
+ * @brief Generate a top-level field.
+ *
+ * @param[out] status - The empty buffer that the field is written to.
+ * @param[in] field - The top-level field.
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @return a result indicating success or failure.
+ */
+res::result_t status_field_generator(std::string& status,
+  sbar_field_t field,
+  persistent_state_t& persistent_state) {
+    switch (field) {
+        case sbar_field_time: {
+            std::time_t epoch_time = std::time(nullptr);
+            std::tm calendar_buffer{};
+            std::tm* calendar_time = localtime_r(&epoch_time, &calendar_buffer);
+
+            // RFC 3339 format
+            sbar::append_integer(status, calendar_time->tm_year + 1900);
+            status += '-';
+            sbar::append_integer(status, calendar_time->tm_mon + 1, 2);
+            status += '-';
+            sbar::append_integer(status, calendar_time->tm_mday, 2);
+            status += ' ';
+            sbar::append_integer(status, calendar_time->tm_hour, 2);
+            status += ':';
+            sbar::append_integer(status, calendar_time->tm_min, 2);
+            status += ':';
+            sbar::append_integer(status, calendar_time->tm_sec, 2);
+
+            return res::success;
+        }
+        case sbar_field_uptime: {
+            if (! persistent_state.system_info.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get the uptime due to a "
                   "previous failure to get the system info.");
             }
 
             std::time_t epoch_uptime =
               persistent_state.system_info->uptime.count();
-            std::tm* calendar_uptime = std::gmtime(&epoch_uptime);
+            std::tm calendar_buffer{};
+            std::tm* calendar_uptime =
+              gmtime_r(&epoch_uptime, &calendar_buffer);
 
             // non-standard format
-            return sprintf("%i-%i %.2i:%.2i:%.2i",
-              calendar_uptime->tm_year - 70,
-              calendar_uptime->tm_yday,
-              calendar_uptime->tm_hour,
-              calendar_uptime->tm_min,
-              calendar_uptime->tm_sec);
+            sbar::append_integer(status, calendar_uptime->tm_year - 70);
+            status += '-';
+            sbar::append_integer(status, calendar_uptime->tm_yday);
+            status += ' ';
+            sbar::append_integer(status, calendar_uptime->tm_hour, 2);
+            status += ':';
+            sbar::append_integer(status, calendar_uptime->tm_min, 2);
+            status += ':';
+            sbar::append_integer(status, calendar_uptime->tm_sec, 2);
+
+            return res::success;
         }
         case sbar_field_disk: {
-            auto disks = syst::get_disks();
-            if (disks.has_error()) {
-                return RES_TRACE(disks.error());
+            if (! persistent_state.disks.has_value()) {
+                return RES_NEW_ERROR("Failed to get disk info due to a "
+                                     "previous failure to get the disks.");
             }
 
-            std::string status;
-
-            for (const auto& disk : disks.value()) {
+            for (const auto& disk : persistent_state.disks.value()) {
                 if (persistent_state.ignore_zero_capacity_disks) {
                     auto disk_size = disk.get_size();
                     if (disk_size.has_error() || disk_size.value() == 0) {
@@ -1016,15 +1832,13 @@ template<typename... field_generator_args_t>
                     }
                 }
 
-                status += make_given_status(persistent_state.disk_fmt,
-                  false,
+                append_given_status(status, persistent_state.disk_fmt,
                   persistent_state,
-                  disk_field_assigner,
-                  disk_field_generator,
+                  disk_field_appender,
                   disk);
             }
 
-            return status;
+            return res::success;
         }
         case sbar_field_swap: {
             if (! persistent_state.system_info.has_value()) {
@@ -1033,8 +1847,10 @@ template<typename... field_generator_args_t>
                   "previous failure to get the system info.");
             }
 
-            return sprintf(
-              "%i", static_cast<int>(persistent_state.system_info->swap_usage));
+            sbar::append_integer(status,
+              static_cast<int>(filter_value(persistent_state, sbar_field_none,
+                field, persistent_state.system_info->swap_usage)));
+            return res::success;
         }
         case sbar_field_memory: {
             if (! persistent_state.system_info.has_value()) {
@@ -1043,8 +1859,10 @@ template<typename... field_generator_args_t>
                   "previous failure to get the system info.");
             }
 
-            return sprintf(
-              "%i", static_cast<int>(persistent_state.system_info->ram_usage));
+            sbar::append_integer(status,
+              static_cast<int>(filter_value(persistent_state, sbar_field_none,
+                field, persistent_state.system_info->ram_usage)));
+            return res::success;
         }
         case sbar_field_cpu: {
             auto usage = persistent_state.cpu_usage.get_total();
@@ -1052,74 +1870,93 @@ template<typename... field_generator_args_t>
                 return RES_TRACE(usage.error());
             }
 
-            return sprintf("%i", static_cast<int>(usage.value()));
+            sbar::append_integer(status,
+              static_cast<int>(filter_value(
+                persistent_state, sbar_field_none, field, usage.value())));
+            return res::success;
         }
         case sbar_field_cpu_per_core: {
-            auto cores = persistent_state.cpu_usage.get_per_core();
-            if (cores.has_error()) {
-                return RES_TRACE(cores.error());
-            }
+            const auto& cores = persistent_state.cpu_usage.get_per_core();
 
-            if (cores->size() == 0) {
-                return std::string{};
+            if (cores.size() == 0) {
+                return res::success;
             }
 
-            std::string status;
+            if (persistent_state.per_core_mode == per_core_mode_t::glyphs) {
+                // Every block character is three bytes of UTF-8.
+                status.reserve(cores.size() * 3);
 
-            for (auto usage : cores.value()) {
-                auto status_part = sprintf("%i ", static_cast<int>(usage));
-                if (status_part.has_error()) {
-                    return RES_TRACE(status_part.error());
+                for (auto usage : cores) {
+                    status += sbar::get_block(usage, 0, 100);
                 }
-                status += status_part.value();
-            }
-
-            status.pop_back();
 
-            return status;
-        }
-        case sbar_field_highest_temp: {
-            auto thermal_zones = syst::get_thermal_zones();
-            if (thermal_zones.has_error()) {
-                return RES_TRACE(thermal_zones.error());
+                return res::success;
             }
 
-            std::optional<double> highest_temp;
-
-            for (const auto& zone : thermal_zones.value()) {
-                auto temp = zone.get_temperature();
-                if (temp.has_error()) {
-                    return RES_TRACE(temp.error());
+            if (persistent_state.per_core_mode == per_core_mode_t::groups
+              && persistent_state.cpu_topology.has_value()) {
+                auto& summaries = persistent_state.cpu_summaries;
+                auto summarize_result =
+                  persistent_state.cpu_topology->summarize(cores, summaries);
+                if (summarize_result.failure()) {
+                    return RES_TRACE(summarize_result.error());
                 }
 
-                if (! highest_temp.has_value()) {
-                    highest_temp = temp.value();
-                    continue;
+                // <lowest>/<average>/<highest> of each group
+                status.reserve(summaries.size() * 12);
+
+                for (const auto& summary : summaries) {
+                    sbar::append_integer(
+                      status, static_cast<int>(summary.lowest));
+                    status += '/';
+                    sbar::append_integer(
+                      status, static_cast<int>(summary.average));
+                    status += '/';
+                    sbar::append_integer(
+                      status, static_cast<int>(summary.highest));
+                    status += ' ';
                 }
 
-                if (temp.value() > highest_temp) {
-                    highest_temp = temp.value();
-                }
+                status.pop_back();
+
+                return res::success;
             }
 
-            if (! highest_temp.has_value()) {
-                return RES_NEW_ERROR(
-                  "Failed to get the highest temperature measurement due to a "
-                  "lack of any thermal measurements.");
+            // At most "100 " for every core.
+            status.reserve(cores.size() * 4);
+
+            for (auto usage : cores) {
+                sbar::append_integer(status, static_cast<int>(usage));
+                status += ' ';
+            }
+
+            status.pop_back();
+
+            return res::success;
+        }
+        case sbar_field_highest_temp: {
+            auto highest_temp = get_highest_temperature(persistent_state);
+            if (highest_temp.has_error()) {
+                return RES_TRACE(highest_temp.error());
             }
 
-            return sprintf("%.0f", highest_temp.value());
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                highest_temp.value()),
+              0);
+            return res::success;
         }
         case sbar_field_lowest_temp: {
-            auto thermal_zones = syst::get_thermal_zones();
-            if (thermal_zones.has_error()) {
-                return RES_TRACE(thermal_zones.error());
+            if (! persistent_state.thermal_zones.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get the lowest temperature measurement due to a "
+                  "previous failure to get the thermal zones.");
             }
 
             std::optional<double> lowest_temp;
 
-            for (const auto& zone : thermal_zones.value()) {
-                auto temp = zone.get_temperature();
+            for (const auto& zone : persistent_state.thermal_zones.value()) {
+                auto temp = get_temperature(persistent_state, zone);
                 if (temp.has_error()) {
                     return RES_TRACE(temp.error());
                 }
@@ -1140,7 +1977,11 @@ template<typename... field_generator_args_t>
                   "lack of any thermal measurements.");
             }
 
-            return sprintf("%.0f", lowest_temp.value());
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                lowest_temp.value()),
+              0);
+            return res::success;
         }
         case sbar_field_load_1: {
             if (! persistent_state.system_info.has_value()) {
@@ -1149,7 +1990,11 @@ template<typename... field_generator_args_t>
                   "previous failure to get the system info.");
             }
 
-            return sprintf("%.2f", persistent_state.system_info->load_1);
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                persistent_state.system_info->load_1),
+              2);
+            return res::success;
         }
         case sbar_field_load_5: {
             if (! persistent_state.system_info.has_value()) {
@@ -1158,7 +2003,11 @@ template<typename... field_generator_args_t>
                   "previous failure to get the system info.");
             }
 
-            return sprintf("%.2f", persistent_state.system_info->load_5);
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                persistent_state.system_info->load_5),
+              2);
+            return res::success;
         }
         case sbar_field_load_15: {
             if (! persistent_state.system_info.has_value()) {
@@ -1167,127 +2016,102 @@ template<typename... field_generator_args_t>
                   "previous failure to get the system info.");
             }
 
-            return sprintf("%.2f", persistent_state.system_info->load_15);
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                persistent_state.system_info->load_15),
+              2);
+            return res::success;
         }
         case sbar_field_backlight: {
-            auto backlights = syst::get_backlights();
-            if (backlights.has_error()) {
-                return RES_TRACE(backlights.error());
+            if (! persistent_state.backlights.has_value()) {
+                return RES_NEW_ERROR("Failed to get backlight info due to a "
+                                     "previous failure to get the backlights.");
             }
 
-            std::string status;
-
-            for (const auto& backlight : backlights.value()) {
-                status += make_given_status(persistent_state.backlight_fmt,
-                  false,
+            for (const auto& backlight : persistent_state.backlights.value()) {
+                append_given_status(status, persistent_state.backlight_fmt,
                   persistent_state,
-                  backlight_field_assigner,
-                  backlight_field_generator,
+                  backlight_field_appender,
                   backlight);
             }
 
-            return status;
+            return res::success;
         }
         case sbar_field_battery: {
-            auto batteries = syst::get_batteries();
-            if (batteries.has_error()) {
-                return RES_TRACE(batteries.error());
+            if (! persistent_state.batteries.has_value()) {
+                return RES_NEW_ERROR("Failed to get battery info due to a "
+                                     "previous failure to get the batteries.");
             }
 
-            std::string status;
-
-            for (const auto& battery : batteries.value()) {
-                status += make_given_status(persistent_state.battery_fmt,
-                  false,
+            for (const auto& battery : persistent_state.batteries.value()) {
+                append_given_status(status, persistent_state.battery_fmt,
                   persistent_state,
-                  battery_field_assigner,
-                  battery_field_generator,
+                  battery_field_appender,
                   battery);
             }
 
-            return status;
+            return res::success;
         }
         case sbar_field_network: {
-            auto network_interfaces = syst::get_network_interfaces();
-            if (network_interfaces.has_error()) {
-                return RES_TRACE(network_interfaces.error());
+            if (! persistent_state.network_interfaces.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get network interface info due to a previous "
+                  "failure to get the network interfaces.");
             }
 
-            std::string status;
-
-            for (const auto& network_interface : network_interfaces.value()) {
-                auto is_physical = network_interface.is_physical();
-                if (is_physical.has_error()) {
-                    std::cerr << is_physical.error() << std::endl;
-                    continue;
-                }
-                if (! is_physical.value()) {
-                    continue;
-                }
-
-                status += make_given_status(persistent_state.network_fmt,
-                  false,
+            for (const auto& network_interface :
+              persistent_state.network_interfaces.value()) {
+                append_given_status(status, persistent_state.network_fmt,
                   persistent_state,
-                  network_field_assigner,
-                  network_field_generator,
+                  network_field_appender,
                   network_interface);
             }
 
-            return status;
+            return res::success;
         }
         case sbar_field_audio_playback: {
-            if (persistent_state.sound_mixer == nullptr) {
+            if (! persistent_state.audio_controls.has_value()) {
                 return RES_NEW_ERROR(
                   "Failed to get audio playback info due to a previous failure "
-                  "to get a sound mixer.");
+                  "to open the ALSA mixer.");
             }
 
-            auto controls = persistent_state.sound_mixer->get_controls();
-
-            std::string status;
-
-            for (const auto& control : controls) {
-                if (! control.has_playback_status()
-                  && ! control.has_playback_volume()) {
+            for (const auto& control :
+              persistent_state.audio_controls.value()) {
+                if (! control.playback_status.has_value()
+                  && ! control.playback_volume.has_value()) {
                     continue;
                 }
 
-                status += make_given_status(persistent_state.audio_playback_fmt,
-                  false,
+                append_given_status(status, persistent_state.audio_playback_fmt,
                   persistent_state,
-                  audio_playback_field_assigner,
-                  audio_playback_field_generator,
+                  audio_playback_field_appender,
                   control);
             }
 
-            return status;
+            return res::success;
         }
         case sbar_field_audio_capture: {
-            if (persistent_state.sound_mixer == nullptr) {
+            if (! persistent_state.audio_controls.has_value()) {
                 return RES_NEW_ERROR(
                   "Failed to get audio capture info due to a previous failure "
-                  "to get a sound mixer.");
+                  "to open the ALSA mixer.");
             }
 
-            auto controls = persistent_state.sound_mixer->get_controls();
-
-            std::string status;
-
-            for (const auto& control : controls) {
-                if (! control.has_capture_status()
-                  && ! control.has_capture_volume()) {
+            for (const auto& control :
+              persistent_state.audio_controls.value()) {
+                if (! control.capture_status.has_value()
+                  && ! control.capture_volume.has_value()) {
                     continue;
                 }
 
-                status += make_given_status(persistent_state.audio_capture_fmt,
-                  false,
+                append_given_status(status, persistent_state.audio_capture_fmt,
                   persistent_state,
-                  audio_capture_field_assigner,
-                  audio_capture_field_generator,
+                  audio_capture_field_appender,
                   control);
             }
 
-            return status;
+            return res::success;
         }
         case sbar_field_username: {
             auto username = syst::get_username();
@@ -1295,34 +2119,80 @@ template<typename... field_generator_args_t>
                 return RES_TRACE(username.error());
             }
 
-            return username.value();
+            status += username.value();
+            return res::success;
         }
         case sbar_field_kernel: {
-            auto running_kernel = syst::get_running_kernel();
-            if (running_kernel.has_error()) {
-                return RES_TRACE(running_kernel.error());
+            if (! persistent_state.running_kernel.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get the kernel version due to a previous failure "
+                  "to get the running kernel.");
             }
 
-            return running_kernel.value();
+            status += persistent_state.running_kernel.value();
+            return res::success;
         }
         case sbar_field_outdated_kernel: {
-            auto running_kernel = syst::get_running_kernel();
-            if (running_kernel.has_error()) {
-                return RES_TRACE(running_kernel.error());
+            if (! persistent_state.running_kernel.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to check for an outdated kernel due to a previous "
+                  "failure to get the running kernel.");
             }
-
-            auto installed_kernels = syst::get_installed_kernels();
-            if (installed_kernels.has_error()) {
-                return RES_TRACE(installed_kernels.error());
+            if (! persistent_state.installed_kernels.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to check for an outdated kernel due to a previous "
+                  "failure to get the installed kernels.");
             }
 
-            for (const auto& version : installed_kernels.value()) {
-                if (version == running_kernel.value()) {
-                    return std::string{ "🟢" };
+            for (const auto& version :
+              persistent_state.installed_kernels.value()) {
+                if (version == persistent_state.running_kernel.value()) {
+                    status += "🟢";
+                    return res::success;
                 }
             }
 
-            return std::string{ "🔴" };
+            status += "🔴";
+            return res::success;
+        }
+        case sbar_field_context_switches: {
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                persistent_state.cpu_usage.get_context_switch_rate()),
+              0);
+            return res::success;
+        }
+        case sbar_field_interrupts: {
+            sbar::append_fixed(status,
+              filter_value(persistent_state, sbar_field_none, field,
+                persistent_state.cpu_usage.get_interrupt_rate()),
+              0);
+            return res::success;
+        }
+        case sbar_field_procs_running: {
+            sbar::append_integer(status,
+              persistent_state.cpu_usage.get_procs_running());
+            return res::success;
+        }
+        case sbar_field_memory_available:
+        case sbar_field_memory_cached:
+        case sbar_field_memory_dirty: {
+            if (! persistent_state.system_info.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get the memory info due to a "
+                  "previous failure to get the system info.");
+            }
+
+            const auto& memory = persistent_state.system_info->memory;
+            uint64_t kibibytes = memory.available;
+            if (field == sbar_field_memory_cached) {
+                kibibytes = memory.cached;
+            } else if (field == sbar_field_memory_dirty) {
+                kibibytes = memory.dirty;
+            }
+
+            sbar::append_storage_size(status, kibibytes * 1024);
+            return res::success;
         }
         default:
             return RES_NEW_ERROR(
@@ -1330,278 +2200,2193 @@ template<typename... field_generator_args_t>
     }
 }
 
-int main(int argc, char** argv) {
-    // Set signal handlers
-
-    auto sigint_result = std::signal(SIGINT, signal_handler);
-    if (sigint_result == SIG_ERR) {
-        std::cerr << "Failed to set the signal handler for SIGINT."
-                  << std::endl;
-        return 1;
+/**
+ * @brief Parse the refresh interval of a top-level field given as
+ * <token>=<milliseconds>.
+ *
+ * @param[in] interval - The interval to parse.
+ */
+[[nodiscard]] res::optional_t<
+  std::pair<sbar_field_t, sbar::scheduler_t::interval_t>>
+parse_interval(const std::string& interval) {
+    auto invalid_interval = RES_NEW_ERROR(
+      "Invalid refresh interval. Expected <token>=<milliseconds>.\n\tinterval: "
+      + interval);
+
+    if (interval.size() < 3 || interval.at(1) != '=') {
+        return invalid_interval;
     }
 
-    auto sigterm_result = std::signal(SIGTERM, signal_handler);
-    if (sigterm_result == SIG_ERR) {
-        std::cerr << "Failed to set the signal handler for SIGTERM."
-                  << std::endl;
-        return 1;
+    sbar_field_t field = status_field_assigner(interval.at(0));
+    if (field == sbar_field_none) {
+        return invalid_interval;
     }
 
-    // Setup the argument parser
-
-    argparse::ArgumentParser argparser{ "status_bar",
-        sbar_get_runtime_version(),
-        argparse::default_arguments::all,
-        true };
-
-    argparser.add_description("Status bar for dwm (https://dwm.suckless.org). "
-                              "Customizable at runtime and updates instantly.");
+    size_t length = 0;
+    unsigned long long milliseconds = 0;
+    try {
+        milliseconds = std::stoull(interval.substr(2), &length);
+    } catch (const std::exception&) {
+        return invalid_interval;
+    }
+    if (length != interval.size() - 2) {
+        return invalid_interval;
+    }
 
-    std::string default_fmt = "/P/C/N/B/D/b /W%c /H° /M%m /S%s | /T | /k /n";
-    argparser.add_argument("-s", "--status")
-      .nargs(1)
-      .help(
-        "custom status with the following interpreted sequences:\n"
-        "    //    a literal /\n"
-        "    /T    current time\n"
-        "    /U    uptime\n"
-        "    /D    disk and partition info | format with --disk-status\n"
-        "    /S    swap usage percent\n"
-        "    /M    memory usage percent\n"
-        "    /W    CPU usage percent total\n"
-        "    /w    CPU usage percent per core\n"
-        "    /H    highest measured temperature (°C)\n"
-        "    /L    lowest measured temperature (°C)\n"
-        "    /1    1 minute load average\n"
-        "    /2    5 minute load average\n"
-        "    /3    15 minute load average\n"
-        "    /b    backlight info | format with --backlight-status\n"
-        "    /B    battery info | format with --battery-status\n"
-        "    /N    network interface info | format with --network-status\n"
-        "    /P    audio playback info | format with --sound-playback-status\n"
-        "    /C    audio capture info | format with --sound-capture-status\n"
-        "    /n    username\n"
-        "    /K    running kernel name\n"
-        "    /k    outdated kernel indicator\n    ")
-      .default_value(default_fmt);
+    return std::pair{ field, sbar::scheduler_t::interval_t(milliseconds) };
+}
 
-    std::string default_disk_fmt = "/P /R/E |";
-    argparser.add_argument("-D", "--disk-status")
-      .nargs(1)
-      .help("custom disk status with the following interpreted sequences:\n"
-            "    //    a literal /\n"
-            "    /N    name\n"
-            "    /O    rotational indicator\n"
-            "    /R    read-only indicator\n"
-            "    /E    removable without shutdown indicator\n"
-            "    /C    size\n"
-            "    /F    in-flight I/O operations\n"
-            "    /P    partition info | format with --partition-status\n    ")
-      .default_value(default_disk_fmt);
+/**
+ * @brief Get the field assigner of the sub-format expanded by a field or
+ * nullptr if the field does not expand a sub-format.
+ *
+ * @param[in] field - The field.
+ */
+[[nodiscard]] sbar::field_assigner_t get_sub_format_assigner(
+  sbar_field_t field) {
+    switch (field) {
+        case sbar_field_disk:
+            return disk_field_assigner;
+        case sbar_field_part:
+            return part_field_assigner;
+        case sbar_field_backlight:
+            return backlight_field_assigner;
+        case sbar_field_battery:
+            return battery_field_assigner;
+        case sbar_field_network:
+            return network_field_assigner;
+        case sbar_field_audio_playback:
+            return audio_playback_field_assigner;
+        case sbar_field_audio_capture:
+            return audio_capture_field_assigner;
+        default:
+            return nullptr;
+    }
+}
 
-    std::string default_partition_fmt = " /M /U%";
-    argparser.add_argument("-P", "--partition-status")
-      .nargs(1)
-      .help("custom disk partition status with the following interpreted "
-            "sequences:\n"
-            "    //    a literal /\n"
-            "    /N    name\n"
-            "    /R    read-only indicator\n"
-            "    /M    mount path\n"
-            "    /T    filesystem type\n"
-            "    /C    size\n"
-            "    /U    usage percent\n"
-            "    /F    in-flight I/O operations\n    ")
-      .default_value(default_partition_fmt);
+/**
+ * @brief Check whether the generator of a field passes its value through
+ * filter_value.
+ *
+ * @param[in] format_field - The field that expands the sub-format containing
+ * the field or sbar_field_none for a top-level field.
+ * @param[in] field - The field.
+ */
+[[nodiscard]] bool is_filterable(
+  sbar_field_t format_field, sbar_field_t field) {
+    switch (format_field) {
+        case sbar_field_none:
+            return field == sbar_field_cpu || field == sbar_field_memory
+              || field == sbar_field_swap || field == sbar_field_highest_temp
+              || field == sbar_field_lowest_temp || field == sbar_field_load_1
+              || field == sbar_field_load_5 || field == sbar_field_load_15
+              || field == sbar_field_context_switches
+              || field == sbar_field_interrupts;
+        case sbar_field_disk:
+        case sbar_field_part:
+            return field == block_field_read_rate
+              || field == block_field_write_rate || field == block_field_iops
+              || field == block_field_utilization;
+        case sbar_field_battery:
+            return field == sbar_field_battery_charge
+              || field == sbar_field_battery_power;
+        case sbar_field_network:
+            return field == network_field_bytes_down_rate
+              || field == network_field_bytes_up_rate
+              || field == network_field_packets_down_rate
+              || field == network_field_packets_up_rate;
+        default:
+            return false;
+    }
+}
 
-    std::string default_backlight_fmt = " /L%l";
-    argparser.add_argument("-b", "--backlight-status")
-      .nargs(1)
-      .help(
-        "custom backlight status with the following interpreted sequences:\n"
-        "    //    a literal /\n"
-        "    /N    name\n"
-        "    /L    brightness\n    ")
-      .default_value(default_backlight_fmt);
+/**
+ * @brief Parse the quantum or hysteresis of a numeric field given as
+ * <tokens>=<number>. The tokens are the token of a top-level field followed
+ * by the tokens that lead to a field within its sub-formats.
+ *
+ * @param[in] argument - The argument to parse.
+ * @return the field that expands the sub-format containing the field (or
+ * sbar_field_none), the field and the number.
+ */
+[[nodiscard]] res::optional_t<std::tuple<sbar_field_t, sbar_field_t, double>>
+parse_value_filter(const std::string& argument) {
+    auto invalid_argument = RES_NEW_ERROR(
+      "Invalid field filter. Expected <tokens>=<number>.\n\targument: "
+      + argument);
+
+    auto separator = argument.find('=');
+    if (separator == 0 || separator == std::string::npos) {
+        return invalid_argument;
+    }
 
-    std::string default_battery_fmt = " /S /N /L% /T |";
-    argparser.add_argument("-B", "--battery-status")
-      .nargs(1)
-      .help("custom battery status with the following interpreted sequences:\n"
-            "    //    a literal /\n"
-            "    /N    name\n"
-            "    /S    status\n"
-            "    /L    charge percent\n"
-            "    /C    capacity percent\n"
-            "    /I    current (A)\n"
-            "    /P    power (W)\n"
-            "    /T    time remaining\n    ")
-      .default_value(default_battery_fmt);
+    sbar_field_t format_field = sbar_field_none;
+    sbar_field_t field = sbar_field_none;
+    sbar::field_assigner_t field_assigner = status_field_assigner;
 
-    std::string default_network_interface_fmt = " /S /N |";
-    argparser.add_argument("-N", "--network-status")
-      .nargs(1)
-      .help("custom network status with the following interpreted sequences:\n"
-            "    //    a literal /\n"
-            "    /N    name\n"
-            "    /S    status\n"
-            "    /R    packets down (received)\n"
-            "    /T    packets up (transmitted)\n"
-            "    /r    bytes down (received)\n"
-            "    /t    bytes up (transmitted)\n    ")
-      .default_value(default_network_interface_fmt);
+    for (size_t index = 0; index < separator; ++index) {
+        if (field != sbar_field_none) {
+            format_field = field;
+            field_assigner = get_sub_format_assigner(field);
+        }
+        if (field_assigner == nullptr) {
+            return invalid_argument;
+        }
 
-    std::string default_audio_playback_fmt = " /S /V% |";
-    argparser.add_argument("-P", "--audio-playback-status")
-      .nargs(1)
-      .help("custom audio playback status with the following interpreted "
-            "sequences:\n"
-            "    //    a literal /\n"
-            "    /N    name\n"
-            "    /S    status\n"
-            "    /V    volume percent\n    ")
-      .default_value(default_audio_playback_fmt);
+        field = field_assigner(argument.at(index));
+        if (field == sbar_field_none) {
+            return invalid_argument;
+        }
+    }
 
-    std::string default_audio_capture_fmt = " /S /V% |";
-    argparser.add_argument("-C", "--audio-capture-status")
-      .nargs(1)
-      .help("custom audio capture status with the following interpreted "
-            "sequences:\n"
-            "    //    a literal /\n"
-            "    /N    name\n"
-            "    /S    status\n"
-            "    /V    volume percent\n    ")
-      .default_value(default_audio_capture_fmt);
+    if (! is_filterable(format_field, field)) {
+        return RES_NEW_ERROR(
+          "The field does not have a numeric value.\n\targument: "
+          + argument);
+    }
 
-    // Parse arguments
+    size_t length = 0;
+    double number = 0;
     try {
-        argparser.parse_args(argc, argv);
-    } catch (const std::exception& err) {
-        std::cerr << err.what() << "\n\n";
-        std::cerr << argparser;
-        return 1;
+        number = std::stod(argument.substr(separator + 1), &length);
+    } catch (const std::exception&) {
+        return invalid_argument;
+    }
+    if (length != argument.size() - separator - 1 || ! std::isfinite(number)
+      || number < 0) {
+        return invalid_argument;
     }
 
-    persistent_state_t persistent_state;
-    persistent_state.status_fmt = argparser.get<std::string>("--status");
-    persistent_state.disk_fmt = argparser.get<std::string>("--disk-status");
-    persistent_state.part_fmt =
-      argparser.get<std::string>("--partition-status");
-    persistent_state.backlight_fmt =
-      argparser.get<std::string>("--backlight-status");
-    persistent_state.battery_fmt =
-      argparser.get<std::string>("--battery-status");
-    persistent_state.network_fmt =
-      argparser.get<std::string>("--network-status");
-    persistent_state.audio_playback_fmt =
-      argparser.get<std::string>("--audio-playback-status");
-    persistent_state.audio_capture_fmt =
-      argparser.get<std::string>("--audio-capture-status");
-    persistent_state.ignore_zero_capacity_disks = true;
+    return std::tuple{ format_field, field, number };
+}
 
-    auto channel = iipc::get_channel(sbar::channel);
-    if (channel.has_error()) {
-        std::cerr << channel.error() << std::endl;
-        return 1;
+/**
+ * @brief Get every field reachable from the top-level format, including the
+ * fields of sub-formats that are expanded by a reachable field.
+ *
+ * @param[in] persistent_state - The state of the status bar.
+ */
+[[nodiscard]] sbar_field_t get_active_fields(
+  const persistent_state_t& persistent_state) {
+    // Ordered so that nested sub-formats follow the format that expands them.
+    const std::vector<std::pair<sbar_field_t, const sbar::format_t*>>
+      sub_formats{
+          { sbar_field_disk, &persistent_state.disk_fmt },
+          { sbar_field_part, &persistent_state.part_fmt },
+          { sbar_field_backlight, &persistent_state.backlight_fmt },
+          { sbar_field_battery, &persistent_state.battery_fmt },
+          { sbar_field_network, &persistent_state.network_fmt },
+          { sbar_field_audio_playback, &persistent_state.audio_playback_fmt },
+          { sbar_field_audio_capture, &persistent_state.audio_capture_fmt },
+      };
+
+    auto active_fields = persistent_state.status_fmt.fields;
+
+    for (const auto& [field, format] : sub_formats) {
+        if ((active_fields & field) != sbar_field_none) {
+            active_fields =
+              static_cast<sbar_field_t>(active_fields | format->fields);
+        }
     }
 
-    auto root_window = sbar::get_root_window();
-    if (root_window.has_error()) {
-        std::cerr << root_window.error() << std::endl;
+    return active_fields;
+}
+
+/**
+ * @brief Store the value of a collector or reset it and report the error.
+ *
+ * @param[out] destination - Where the collected value is stored.
+ * @param[in] result - The collected value or an error.
+ * @return whether the value was collected.
+ */
+template<typename value_t>
+bool collect(
+  std::optional<value_t>& destination, res::optional_t<value_t> result) {
+    if (result.has_value()) {
+        destination = std::move(result.value());
+        return true;
+    }
+
+    destination = std::nullopt;
+    std::cerr << result.error() << std::endl;
+    return false;
+}
+
+/**
+ * @brief Mark event-driven collectors to be run again on the next
+ * collection.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] collectors - The collectors whose sources changed.
+ */
+void mark_stale(
+  persistent_state_t& persistent_state, sbar::collector_t collectors) {
+    persistent_state.stale_collectors = static_cast<sbar::collector_t>(
+      persistent_state.stale_collectors | collectors);
+}
+
+/**
+ * @brief Check whether epoll reported an error or hang up for a file
+ * descriptor.
+ *
+ * @param[in] events - The epoll events reported for the file descriptor.
+ */
+[[nodiscard]] bool has_failed(uint32_t events) {
+    return (events & (EPOLLERR | EPOLLHUP)) != 0;
+}
+
+/**
+ * @brief Get the temperature attributes of the thermal zones.
+ */
+[[nodiscard]] res::optional_t<std::vector<std::filesystem::path>>
+get_thermal_zones() {
+    std::vector<std::filesystem::path> thermal_zones;
+
+    std::error_code error;
+    for (const auto& entry :
+      std::filesystem::directory_iterator(sysfs_thermal, error)) {
+        if (entry.path().filename().string().rfind("thermal_zone", 0) == 0) {
+            thermal_zones.push_back(entry.path() / "temp");
+        }
+    }
+    if (error) {
+        return RES_NEW_ERROR("Failed to list the thermal zones.\n\terror: "
+          + error.message());
+    }
+
+    return thermal_zones;
+}
+
+/**
+ * @brief Get the network interfaces that are backed by physical devices.
+ */
+[[nodiscard]] res::optional_t<std::vector<syst::network_interface_t>>
+get_physical_network_interfaces() {
+    auto network_interfaces = syst::get_network_interfaces();
+    if (network_interfaces.has_error()) {
+        return RES_TRACE(network_interfaces.error());
+    }
+
+    std::vector<syst::network_interface_t> physical_network_interfaces;
+
+    for (auto& network_interface : network_interfaces.value()) {
+        auto is_physical = network_interface.is_physical();
+        if (is_physical.has_error()) {
+            std::cerr << is_physical.error() << std::endl;
+            continue;
+        }
+        if (is_physical.value()) {
+            physical_network_interfaces.push_back(
+              std::move(network_interface));
+        }
+    }
+
+    return physical_network_interfaces;
+}
+
+/**
+ * @brief Close the cached sysfs attributes read for the given collectors.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] collectors - The collectors whose devices were added or removed.
+ */
+void invalidate_attributes(
+  persistent_state_t& persistent_state, sbar::collector_t collectors) {
+    const std::array<std::pair<sbar::collector_t, std::filesystem::path>, 4>
+      directories{ {
+        { sbar::collector_disks, sysfs_block },
+        { sbar::collector_backlights, sysfs_backlight },
+        { sbar::collector_batteries, sysfs_power_supply },
+        { sbar::collector_thermal_zones, sysfs_thermal },
+      } };
+
+    for (const auto& [collector, directory] : directories) {
+        if ((collectors & collector) != sbar::collector_none) {
+            persistent_state.sysfs_cache.invalidate(directory);
+        }
+    }
+}
+
+/**
+ * @brief Gather the system information required by the given collectors.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] collectors - The collectors to run.
+ * @return the collectors that failed.
+ */
+[[nodiscard]] sbar::collector_t run_collectors(
+  persistent_state_t& persistent_state, sbar::collector_t collectors) {
+    unsigned failed_collectors = sbar::collector_none;
+
+    if ((collectors & sbar::collector_cpu_usage) != 0) {
+        auto contents = persistent_state.proc_stat.read();
+        if (contents.has_value()) {
+            auto update_result = persistent_state.cpu_usage.update(
+              contents.value(), sbar::cpu_usage_t::clock_t::now());
+            if (update_result.failure()) {
+                std::cerr << update_result.error() << std::endl;
+            }
+        } else {
+            std::cerr << contents.error() << std::endl;
+        }
+    }
+
+    if ((collectors & sbar::collector_system_info) != 0) {
+        collect(persistent_state.system_info,
+          sbar::get_system_info(
+            persistent_state.proc_meminfo, persistent_state.proc_loadavg));
+    }
+
+    // The monitor keeps its copy of the controls up to date. The main loop
+    // reopens the mixer while there is no monitor.
+    if ((collectors & sbar::collector_sound_mixer) != 0) {
+        auto audio_monitor = std::atomic_load(&persistent_state.audio_monitor);
+        if (audio_monitor != nullptr) {
+            persistent_state.audio_controls = audio_monitor->get_controls();
+        } else {
+            persistent_state.audio_controls.reset();
+            failed_collectors |= sbar::collector_sound_mixer;
+        }
+    }
+
+    if ((collectors & sbar::collector_disks) != 0
+      && ! collect(persistent_state.disks, syst::get_disks())) {
+        failed_collectors |= sbar::collector_disks;
+    }
+
+    if ((collectors & sbar::collector_thermal_zones) != 0
+      && ! collect(persistent_state.thermal_zones, get_thermal_zones())) {
+        failed_collectors |= sbar::collector_thermal_zones;
+    }
+
+    if ((collectors & sbar::collector_backlights) != 0
+      && ! collect(persistent_state.backlights, syst::get_backlights())) {
+        failed_collectors |= sbar::collector_backlights;
+    }
+
+    if ((collectors & sbar::collector_batteries) != 0
+      && ! collect(persistent_state.batteries, syst::get_batteries())) {
+        failed_collectors |= sbar::collector_batteries;
+    }
+
+    if ((collectors & sbar::collector_network_interfaces) != 0
+      && ! collect(persistent_state.network_interfaces,
+        get_physical_network_interfaces())) {
+        failed_collectors |= sbar::collector_network_interfaces;
+    }
+
+    if ((collectors & sbar::collector_running_kernel) != 0
+      && ! collect(
+        persistent_state.running_kernel, syst::get_running_kernel())) {
+        failed_collectors |= sbar::collector_running_kernel;
+    }
+
+    if ((collectors & sbar::collector_installed_kernels) != 0
+      && ! collect(persistent_state.installed_kernels,
+        syst::get_installed_kernels())) {
+        failed_collectors |= sbar::collector_installed_kernels;
+    }
+
+    return static_cast<sbar::collector_t>(failed_collectors);
+}
+
+/**
+ * @brief Top-level fields that are generated together on a worker thread
+ * because they share collectors.
+ */
+struct job_t {
+    sbar_field_t fields = sbar_field_none;
+    sbar::collector_t collectors = sbar::collector_none;
+};
+
+/**
+ * @brief The values of the fields generated by a job.
+ */
+struct job_result_t {
+    sbar::collector_t failed_collectors = sbar::collector_none;
+
+    // the slots of persistent_state_t::field_values that were written (see
+    // segment_t::index)
+    std::bitset<2 * sbar::history_index_offset> values;
+};
+
+/**
+ * @brief Split top-level fields into jobs that share no collectors so that
+ * the jobs can run in parallel.
+ *
+ * @param[in] fields - The top-level fields to generate.
+ */
+[[nodiscard]] std::vector<job_t> split_into_jobs(sbar_field_t fields) {
+    std::vector<job_t> jobs;
+
+    for (size_t index = 0; index < sbar_total_fields; ++index) {
+        auto field = static_cast<sbar_field_t>(1ULL << index);
+        if ((field & fields) == sbar_field_none) {
+            continue;
+        }
+
+        job_t job{ field, sbar::get_collectors(field) };
+
+        // Merge every job that shares a collector with this field.
+        for (auto other = jobs.begin(); other != jobs.end();) {
+            if ((other->collectors & job.collectors) == sbar::collector_none) {
+                ++other;
+                continue;
+            }
+            job.fields = static_cast<sbar_field_t>(job.fields | other->fields);
+            job.collectors = static_cast<sbar::collector_t>(
+              job.collectors | other->collectors);
+            other = jobs.erase(other);
+        }
+
+        jobs.push_back(job);
+    }
+
+    return jobs;
+}
+
+/**
+ * @brief Check whether any network rate is shown or recorded in a history.
+ *
+ * @param[in] persistent_state - The state of the status bar.
+ */
+[[nodiscard]] bool uses_network_rates(
+  const persistent_state_t& persistent_state) {
+    if ((persistent_state.status_fmt.history_fields & sbar_field_network)
+      != sbar_field_none) {
+        return true;
+    }
+
+    return std::any_of(persistent_state.network_fmt.segments.begin(),
+      persistent_state.network_fmt.segments.end(),
+      [](const sbar::segment_t& segment) {
+          return segment.field == network_field_bytes_down_rate
+            || segment.field == network_field_bytes_up_rate
+            || segment.field == network_field_packets_down_rate
+            || segment.field == network_field_packets_up_rate;
+      });
+}
+
+/**
+ * @brief Check whether any disk or partition rate is shown.
+ *
+ * @param[in] persistent_state - The state of the status bar.
+ */
+[[nodiscard]] bool uses_block_rates(
+  const persistent_state_t& persistent_state) {
+    auto is_block_rate = [](const sbar::segment_t& segment) {
+        return segment.field == block_field_read_rate
+          || segment.field == block_field_write_rate
+          || segment.field == block_field_iops
+          || segment.field == block_field_utilization;
+    };
+
+    return std::any_of(persistent_state.disk_fmt.segments.begin(),
+             persistent_state.disk_fmt.segments.end(),
+             is_block_rate)
+      || std::any_of(persistent_state.part_fmt.segments.begin(),
+        persistent_state.part_fmt.segments.end(),
+        is_block_rate);
+}
+
+/**
+ * @brief Sample the counters of a disk or partition.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] name - The name of the block device.
+ * @param[in] now - The time at which the sample is taken.
+ */
+void sample_block_rates(persistent_state_t& persistent_state,
+  const std::string& name,
+  sbar::rate_tracker_t<5>::clock_t::time_point now) {
+    auto counters = get_block_counters(persistent_state, name);
+    if (counters.has_value()) {
+        persistent_state.block_rates.sample(name, counters.value(), now);
+    }
+}
+
+/**
+ * @brief Sample the counters that rates are derived from. Only periodic
+ * refreshes take samples, so refreshes caused by notifications and events
+ * never shorten the period that a rate is measured over.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] scheduled_fields - The fields refreshed on their schedule.
+ */
+void sample_rates(
+  persistent_state_t& persistent_state, sbar_field_t scheduled_fields) {
+    if ((scheduled_fields & sbar_field_network) != sbar_field_none
+      && persistent_state.network_interfaces.has_value()
+      && uses_network_rates(persistent_state)) {
+        auto now = sbar::rate_tracker_t<4>::clock_t::now();
+
+        for (const auto& network_interface :
+          persistent_state.network_interfaces.value()) {
+            const auto& stat =
+              get_network_stat(persistent_state, network_interface);
+            if (stat.has_error()) {
+                continue;
+            }
+
+            sbar::rate_tracker_t<4>::counters_t counters{};
+            counters.at(network_rate_bytes_down) = stat->bytes_down;
+            counters.at(network_rate_bytes_up) = stat->bytes_up;
+            counters.at(network_rate_packets_down) = stat->packets_down;
+            counters.at(network_rate_packets_up) = stat->packets_up;
+
+            persistent_state.network_rates.sample(
+              network_interface.get_name(), counters, now);
+        }
+
+        persistent_state.network_rates.forget_before(now);
+    }
+
+    if ((scheduled_fields & sbar_field_disk) != sbar_field_none
+      && persistent_state.disks.has_value()
+      && uses_block_rates(persistent_state)) {
+        auto now = sbar::rate_tracker_t<5>::clock_t::now();
+
+        for (const auto& disk : persistent_state.disks.value()) {
+            sample_block_rates(persistent_state, disk.get_name(), now);
+
+            const auto& parts = get_parts(persistent_state, disk);
+            if (parts.has_error()) {
+                continue;
+            }
+            for (const auto& part : parts.value()) {
+                sample_block_rates(persistent_state, part.get_name(), now);
+            }
+        }
+
+        persistent_state.block_rates.forget_before(now);
+    }
+}
+
+/**
+ * @brief Read the current value of a metric from the results of its
+ * collector.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] metric - The metric to read.
+ */
+[[nodiscard]] res::optional_t<double> read_history_sample(
+  persistent_state_t& persistent_state, history_metric_t metric) {
+    switch (metric) {
+        case history_cpu: {
+            auto usage = persistent_state.cpu_usage.get_total();
+            if (usage.has_error()) {
+                return RES_TRACE(usage.error());
+            }
+
+            return static_cast<double>(usage.value());
+        }
+        case history_memory: {
+            if (! persistent_state.system_info.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get the memory usage due to a "
+                  "previous failure to get the system info.");
+            }
+
+            return static_cast<double>(persistent_state.system_info->ram_usage);
+        }
+        case history_highest_temp: {
+            return get_highest_temperature(persistent_state);
+        }
+        case history_network: {
+            if (! persistent_state.network_interfaces.has_value()) {
+                return RES_NEW_ERROR(
+                  "Failed to get the network throughput due to a "
+                  "previous failure to get the network interfaces.");
+            }
+
+            // Bytes down and up per second of every interface.
+            double throughput = 0;
+            for (const auto& network_interface :
+              persistent_state.network_interfaces.value()) {
+                auto rates = persistent_state.network_rates.get_rates(
+                  network_interface.get_name());
+                if (rates.has_value()) {
+                    throughput += rates->at(network_rate_bytes_down)
+                      + rates->at(network_rate_bytes_up);
+                }
+            }
+
+            return throughput;
+        }
+        default:
+            return RES_NEW_ERROR(
+              "Invalid history metric: " + std::to_string(metric));
+    }
+}
+
+/**
+ * @brief Record a sample of every shown history. Like rates, histories are
+ * only sampled by periodic refreshes so that their samples are evenly
+ * spaced.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] scheduled_fields - The fields refreshed on their schedule.
+ */
+void sample_histories(
+  persistent_state_t& persistent_state, sbar_field_t scheduled_fields) {
+    auto fields = static_cast<sbar_field_t>(
+      scheduled_fields & persistent_state.status_fmt.history_fields);
+
+    for (size_t index = 0; index < sbar_total_fields; ++index) {
+        auto field = static_cast<sbar_field_t>(1ULL << index);
+        if ((field & fields) == sbar_field_none) {
+            continue;
+        }
+
+        auto metric = get_history_metric(field);
+        if (! metric.has_value()) {
+            continue;
+        }
+
+        auto sample = read_history_sample(persistent_state, metric.value());
+        if (sample.has_error()) {
+            continue;
+        }
+
+        persistent_state.histories.at(metric.value()).push(sample.value());
+    }
+}
+
+/**
+ * @brief Render the history of a field as a sparkline.
+ *
+ * @param[out] status - The empty buffer that the sparkline is written to.
+ * @param[in] field - A field returned by history_field_assigner.
+ * @param[in] persistent_state - The state of the status bar.
+ * @return a result indicating success or failure.
+ */
+res::result_t history_field_generator(std::string& status,
+  sbar_field_t field,
+  const persistent_state_t& persistent_state) {
+    auto metric = get_history_metric(field);
+    if (! metric.has_value()) {
+        return RES_NEW_ERROR("Invalid field value: " + std::to_string(field));
+    }
+
+    const auto& history = persistent_state.histories.at(metric.value());
+    auto width = persistent_state.sparkline_width;
+
+    switch (metric.value()) {
+        case history_cpu:
+        case history_memory:
+            history.append_sparkline(status, width, 0, 100);
+            break;
+        case history_network:
+            history.append_sparkline(status, width, 0);
+            break;
+        default:
+            history.append_sparkline(status, width);
+            break;
+    }
+
+    return res::success;
+}
+
+/**
+ * @brief Discard the readings taken by a previous job. The entries of the
+ * readings are kept so that the next job reuses them.
+ *
+ * @param[in, out] readings - The readings of a collector.
+ * @param[in] enumerated - Whether the devices of the collector are
+ * enumerated again by the next job, which removes the entries.
+ */
+template<typename value_t>
+void clear_readings(
+  snapshot_t::readings_t<value_t>& readings, bool enumerated) {
+    if (enumerated) {
+        readings.clear();
+        return;
+    }
+
+    for (auto& reading : readings) {
+        reading.second.reset();
+    }
+}
+
+/**
+ * @brief Discard the readings of the given collectors taken by a previous
+ * job.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] owned_collectors - The collectors owned by the next job.
+ * @param[in] collectors - The collectors that the next job runs first.
+ */
+void clear_snapshot(persistent_state_t& persistent_state,
+  sbar::collector_t owned_collectors,
+  sbar::collector_t collectors) {
+    auto& snapshot = persistent_state.snapshot;
+
+    auto is_owned = [&](sbar::collector_t collector) {
+        return (owned_collectors & collector) != sbar::collector_none;
+    };
+    auto is_run = [&](sbar::collector_t collector) {
+        return (collectors & collector) != sbar::collector_none;
+    };
+
+    if (is_owned(sbar::collector_disks)) {
+        clear_readings(snapshot.parts, is_run(sbar::collector_disks));
+        clear_readings(snapshot.mount_infos, is_run(sbar::collector_disks));
+    }
+    if (is_owned(sbar::collector_thermal_zones)) {
+        clear_readings(
+          snapshot.temperatures, is_run(sbar::collector_thermal_zones));
+    }
+    if (is_owned(sbar::collector_batteries)) {
+        clear_readings(
+          snapshot.battery_statuses, is_run(sbar::collector_batteries));
+        clear_readings(
+          snapshot.battery_charges, is_run(sbar::collector_batteries));
+    }
+    if (is_owned(sbar::collector_network_interfaces)) {
+        clear_readings(snapshot.network_stats,
+          is_run(sbar::collector_network_interfaces));
+    }
+}
+
+/**
+ * @brief Find the sysfs attributes of the devices enumerated by the given
+ * collectors.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] collectors - The collectors that enumerated their devices.
+ */
+void enumerate_attributes(
+  persistent_state_t& persistent_state, sbar::collector_t collectors) {
+    if ((collectors & sbar::collector_disks) != sbar::collector_none
+      && persistent_state.disks.has_value()) {
+        auto& block_attributes = persistent_state.block_attributes;
+        block_attributes.clear();
+
+        for (const auto& disk : persistent_state.disks.value()) {
+            block_attributes.emplace(
+              disk.get_name(), make_block_attributes(disk.get_name()));
+
+            const auto& parts = get_parts(persistent_state, disk);
+            if (parts.has_error()) {
+                continue;
+            }
+            for (const auto& part : parts.value()) {
+                block_attributes.emplace(
+                  part.get_name(), make_block_attributes(part.get_name()));
+            }
+        }
+    }
+
+    if ((collectors & sbar::collector_backlights) != sbar::collector_none
+      && persistent_state.backlights.has_value()) {
+        auto& backlight_attributes = persistent_state.backlight_attributes;
+        backlight_attributes.clear();
+
+        for (const auto& backlight : persistent_state.backlights.value()) {
+            backlight_attributes.emplace(backlight.get_name(),
+              make_backlight_attributes(backlight.get_name()));
+        }
+    }
+
+    if ((collectors & sbar::collector_batteries) != sbar::collector_none
+      && persistent_state.batteries.has_value()) {
+        auto& battery_attributes = persistent_state.battery_attributes;
+        battery_attributes.clear();
+
+        for (const auto& battery : persistent_state.batteries.value()) {
+            battery_attributes.emplace(
+              battery.get_name(), make_battery_attributes(battery.get_name()));
+        }
+    }
+}
+
+/**
+ * @brief Run the collectors of a job and generate its fields. Called from a
+ * worker thread.
+ *
+ * @param[in, out] persistent_state - The state of the status bar.
+ * @param[in] job - The fields to generate and the collectors they own.
+ * @param[in] collectors - The collectors to run first.
+ * @param[in] scheduled_fields - The fields of the job refreshed on their
+ * schedule.
+ */
+[[nodiscard]] job_result_t run_job(persistent_state_t& persistent_state,
+  const job_t& job,
+  sbar::collector_t collectors,
+  sbar_field_t scheduled_fields) {
+    clear_snapshot(persistent_state, job.collectors, collectors);
+
+    job_result_t result;
+    result.failed_collectors = run_collectors(persistent_state, collectors);
+    enumerate_attributes(persistent_state,
+      static_cast<sbar::collector_t>(collectors & ~result.failed_collectors));
+    sample_rates(persistent_state, scheduled_fields);
+    sample_histories(persistent_state, scheduled_fields);
+
+    for (size_t index = 0; index < sbar_total_fields; ++index) {
+        auto field = static_cast<sbar_field_t>(1ULL << index);
+        if ((field & job.fields) == sbar_field_none) {
+            continue;
+        }
+
+        auto& value = persistent_state.field_values.at(index);
+        value.clear();
+        auto value_result =
+          status_field_generator(value, field, persistent_state);
+        if (value_result.failure()) {
+            value = error_status;
+            std::cerr << value_result.error() << std::endl;
+        }
+        result.values.set(index);
+
+        if ((field & persistent_state.status_fmt.history_fields)
+          == sbar_field_none) {
+            continue;
+        }
+
+        auto& history = persistent_state.field_values.at(
+          index + sbar::history_index_offset);
+        history.clear();
+        auto history_result =
+          history_field_generator(history, field, persistent_state);
+        if (history_result.failure()) {
+            history = error_status;
+            std::cerr << history_result.error() << std::endl;
+        }
+        result.values.set(index + sbar::history_index_offset);
+    }
+
+    // Every current mount is probed while the disks are generated, so the
+    // mounts that were not probed have disappeared.
+    if ((job.fields & sbar_field_disk) != sbar_field_none
+      && persistent_state.disks.has_value()) {
+        persistent_state.mount_prober.forget_unused();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Print the number of titles sent to the X server and the number
+ * suppressed because they were unchanged.
+ *
+ * @param[in] root_window - The root window that the titles were sent to.
+ */
+void report_title_updates(const sbar::root_window_t& root_window) {
+    std::cerr << "Title updates: " << root_window.published_updates()
+              << " published, " << root_window.suppressed_updates()
+              << " suppressed" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    // Receive termination signals and requests for statistics (SIGUSR1)
+    // through a file descriptor
+
+    auto signal_fd = sbar::get_signal_fd({ SIGINT, SIGTERM, SIGUSR1 });
+    if (signal_fd.has_error()) {
+        std::cerr << signal_fd.error() << std::endl;
+        return 1;
+    }
+
+    // Writing to a lost connection to the X server must fail instead of
+    // terminating the process.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Setup the argument parser
+
+    argparse::ArgumentParser argparser{ "status_bar",
+        sbar_get_runtime_version(),
+        argparse::default_arguments::all,
+        true };
+
+    argparser.add_description("Status bar for dwm (https://dwm.suckless.org). "
+                              "Customizable at runtime and updates instantly.");
+    argparser.add_epilog("Send SIGUSR1 to print the number of titles sent to "
+                         "the X server and the number suppressed because "
+                         "they were unchanged.");
+
+    std::string default_fmt = "/P/C/N/B/D/b /W%c /H° /M%m /S%s | /T | /k /n";
+    argparser.add_argument("-s", "--status")
+      .nargs(1)
+      .help(
+        "custom status with the following interpreted sequences:\n"
+        "    //    a literal /\n"
+        "    /T    current time\n"
+        "    /U    uptime\n"
+        "    /D    disk and partition info | format with --disk-status\n"
+        "    /S    swap usage percent\n"
+        "    /M    memory usage percent\n"
+        "    /W    CPU usage percent total\n"
+        "    /w    CPU usage percent per core\n"
+        "    /H    highest measured temperature (°C)\n"
+        "    /L    lowest measured temperature (°C)\n"
+        "    /1    1 minute load average\n"
+        "    /2    5 minute load average\n"
+        "    /3    15 minute load average\n"
+        "    /b    backlight info | format with --backlight-status\n"
+        "    /B    battery info | format with --battery-status\n"
+        "    /N    network interface info | format with --network-status\n"
+        "    /P    audio playback info | format with --sound-playback-status\n"
+        "    /C    audio capture info | format with --sound-capture-status\n"
+        "    /n    username\n"
+        "    /K    running kernel name\n"
+        "    /k    outdated kernel indicator\n"
+        "    /x    context switches per second\n"
+        "    /i    interrupts per second\n"
+        "    /r    runnable processes\n"
+        "    /a    available memory\n"
+        "    /c    memory used by the page cache\n"
+        "    /d    memory waiting to be written to disk\n"
+        "    /~W   CPU usage history\n"
+        "    /~M   memory usage history\n"
+        "    /~H   highest temperature history\n"
+        "    /~N   network throughput history\n    ")
+      .default_value(default_fmt);
+
+    std::string default_disk_fmt = "/P /R/E |";
+    argparser.add_argument("-D", "--disk-status")
+      .nargs(1)
+      .help("custom disk status with the following interpreted sequences:\n"
+            "    //    a literal /\n"
+            "    /N    name\n"
+            "    /O    rotational indicator\n"
+            "    /R    read-only indicator\n"
+            "    /E    removable without shutdown indicator\n"
+            "    /C    size\n"
+            "    /F    in-flight I/O operations\n"
+            "    /r    bytes read per second\n"
+            "    /w    bytes written per second\n"
+            "    /I    I/O operations per second\n"
+            "    /B    percent of time spent doing I/O\n"
+            "    /P    partition info | format with --partition-status\n    ")
+      .default_value(default_disk_fmt);
+
+    std::string default_partition_fmt = " /M /U%";
+    argparser.add_argument("-P", "--partition-status")
+      .nargs(1)
+      .help("custom disk partition status with the following interpreted "
+            "sequences:\n"
+            "    //    a literal /\n"
+            "    /N    name\n"
+            "    /R    read-only indicator\n"
+            "    /M    mount path\n"
+            "    /T    filesystem type\n"
+            "    /C    size\n"
+            "    /U    usage percent\n"
+            "    /F    in-flight I/O operations\n"
+            "    /r    bytes read per second\n"
+            "    /w    bytes written per second\n"
+            "    /I    I/O operations per second\n"
+            "    /B    percent of time spent doing I/O\n    ")
+      .default_value(default_partition_fmt);
+
+    std::string default_backlight_fmt = " /L%l";
+    argparser.add_argument("-b", "--backlight-status")
+      .nargs(1)
+      .help(
+        "custom backlight status with the following interpreted sequences:\n"
+        "    //    a literal /\n"
+        "    /N    name\n"
+        "    /L    brightness\n    ")
+      .default_value(default_backlight_fmt);
+
+    std::string default_battery_fmt = " /S /N /L% /T |";
+    argparser.add_argument("-B", "--battery-status")
+      .nargs(1)
+      .help("custom battery status with the following interpreted sequences:\n"
+            "    //    a literal /\n"
+            "    /N    name\n"
+            "    /S    status\n"
+            "    /L    charge percent\n"
+            "    /C    capacity percent\n"
+            "    /I    current (A)\n"
+            "    /P    power (W)\n"
+            "    /T    time remaining\n    ")
+      .default_value(default_battery_fmt);
+
+    std::string default_network_interface_fmt = " /S /N |";
+    argparser.add_argument("-N", "--network-status")
+      .nargs(1)
+      .help("custom network status with the following interpreted sequences:\n"
+            "    //    a literal /\n"
+            "    /N    name\n"
+            "    /S    status\n"
+            "    /R    packets down (received)\n"
+            "    /T    packets up (transmitted)\n"
+            "    /r    bytes down (received)\n"
+            "    /t    bytes up (transmitted)\n"
+            "    /D    packets down per second\n"
+            "    /U    packets up per second\n"
+            "    /d    bytes down per second\n"
+            "    /u    bytes up per second\n    ")
+      .default_value(default_network_interface_fmt);
+
+    std::string default_audio_playback_fmt = " /S /V% |";
+    argparser.add_argument("-P", "--audio-playback-status")
+      .nargs(1)
+      .help("custom audio playback status with the following interpreted "
+            "sequences:\n"
+            "    //    a literal /\n"
+            "    /N    name\n"
+            "    /S    status\n"
+            "    /V    volume percent\n    ")
+      .default_value(default_audio_playback_fmt);
+
+    std::string default_audio_capture_fmt = " /S /V% |";
+    argparser.add_argument("-C", "--audio-capture-status")
+      .nargs(1)
+      .help("custom audio capture status with the following interpreted "
+            "sequences:\n"
+            "    //    a literal /\n"
+            "    /N    name\n"
+            "    /S    status\n"
+            "    /V    volume percent\n    ")
+      .default_value(default_audio_capture_fmt);
+
+    const sbar::scheduler_t::interval_t default_interval{ 1000 };
+    argparser.add_argument("--workers")
+      .nargs(1)
+      .scan<'u', unsigned>()
+      .default_value(4U)
+      .help("number of threads that generate fields\n    ");
+
+    argparser.add_argument("--collector-deadline")
+      .nargs(1)
+      .scan<'u', unsigned>()
+      .default_value(100U)
+      .help("milliseconds to wait for the fields of a refresh before the\n"
+            "    title is updated with the previous values of late fields\n"
+            "    ");
+
+    argparser.add_argument("--min-frame-interval")
+      .nargs(1)
+      .scan<'u', unsigned>()
+      .default_value(16U)
+      .help("minimum milliseconds between updates of the title so that\n"
+            "    bursts of changes are shown at once\n    ");
+
+    argparser.add_argument("--mount-timeout")
+      .nargs(1)
+      .scan<'u', unsigned>()
+      .default_value(250U)
+      .help("milliseconds to wait for a mount to report its usage before it\n"
+            "    is marked unresponsive and skipped until it responds again\n"
+            "    ");
+
+    argparser.add_argument("--per-core")
+      .nargs(1)
+      .default_value(std::string{ "values" })
+      .help("how /w shows the usage of each core:\n"
+            "    values    the usage of every core\n"
+            "    glyphs    a block character for every core\n"
+            "    socket    lowest/average/highest of each socket\n"
+            "    cache     lowest/average/highest of each group of cores\n"
+            "              sharing a level 3 cache (e.g. a CCX)\n"
+            "    numa      lowest/average/highest of each NUMA node\n    ");
+
+    argparser.add_argument("--sparkline-width")
+      .nargs(1)
+      .scan<'u', unsigned>()
+      .default_value(20U)
+      .help("number of samples shown by a history (at most "
+        + std::to_string(sbar::history_t::capacity)
+        + ")\n    ");
+
+    argparser.add_argument("--stale-marker")
+      .nargs(1)
+      .default_value(std::string{})
+      .help("text appended to the previous value of a late field\n    ");
+
+    argparser.add_argument("-i", "--interval")
+      .append()
+      .help("refresh interval of a top-level field given as "
+            "<token>=<milliseconds>\n"
+            "    fields within a sub-format are refreshed with the field that\n"
+            "    expands them (e.g. D=5000 for --disk-status)\n"
+            "    an interval of 0 generates the field only once\n"
+            "    by default /n and /K are generated once, /k every 60000 ms,\n"
+            "    and all other fields every 1000 ms\n    ");
+
+    argparser.add_argument("--quantize")
+      .append()
+      .help("round a numeric field to the nearest multiple of a step given "
+            "as\n"
+            "    <tokens>=<step> (e.g. H=2)\n"
+            "    <tokens> is the token of a top-level field followed by the\n"
+            "    tokens of a field within its sub-formats (e.g. Nd=1024 for\n"
+            "    /d of --network-status or DPr for /r of --partition-status)\n"
+            "    supported by /W /M /S /H /L /1 /2 /3 /x /i, /L /P of\n"
+            "    --battery-status, /d /u /D /U of --network-status, and\n"
+            "    /r /w /I /B of --disk-status and --partition-status\n    ");
+
+    argparser.add_argument("--hysteresis")
+      .append()
+      .help("keep showing the previous value of a numeric field until it\n"
+            "    changes by at least a threshold given as\n"
+            "    <tokens>=<threshold> (e.g. W=3)\n"
+            "    applied before --quantize and supported by the same fields\n"
+            "    ");
+
+    // Parse arguments
+    try {
+        argparser.parse_args(argc, argv);
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << "\n\n";
+        std::cerr << argparser;
+        return 1;
+    }
+
+    persistent_state_t persistent_state;
+
+    const std::vector<std::tuple<const char*,
+      sbar::field_assigner_t,
+      sbar::field_assigner_t,
+      sbar::format_t*>>
+      formats{
+          { "--status",
+            status_field_assigner,
+            history_field_assigner,
+            &persistent_state.status_fmt },
+          { "--disk-status",
+            disk_field_assigner,
+            nullptr,
+            &persistent_state.disk_fmt },
+          { "--partition-status",
+            part_field_assigner,
+            nullptr,
+            &persistent_state.part_fmt },
+          { "--backlight-status",
+            backlight_field_assigner,
+            nullptr,
+            &persistent_state.backlight_fmt },
+          { "--battery-status",
+            battery_field_assigner,
+            nullptr,
+            &persistent_state.battery_fmt },
+          { "--network-status",
+            network_field_assigner,
+            nullptr,
+            &persistent_state.network_fmt },
+          { "--audio-playback-status",
+            audio_playback_field_assigner,
+            nullptr,
+            &persistent_state.audio_playback_fmt },
+          { "--audio-capture-status",
+            audio_capture_field_assigner,
+            nullptr,
+            &persistent_state.audio_capture_fmt },
+      };
+
+    // Compile every format up front so that invalid tokens are reported once.
+    for (const auto& [argument, field_assigner, history_assigner, format] :
+      formats) {
+        auto compiled =
+          sbar::compile_format(argparser.get<std::string>(argument),
+            field_assigner,
+            history_assigner);
+        if (compiled.has_error()) {
+            std::cerr << compiled.error() << std::endl;
+            return 1;
+        }
+        *format = std::move(compiled.value());
+    }
+    persistent_state.status =
+      sbar::status_buffer_t{ persistent_state.status_fmt };
+    persistent_state.active_fields = get_active_fields(persistent_state);
+
+    // Audio fields are refreshed when the mixer reports a change instead of
+    // being reloaded periodically. The mixer is opened once the event loop
+    // exists and opened again later if it is unavailable.
+    const auto audio_fields = static_cast<sbar_field_t>(
+      sbar_field_audio_playback | sbar_field_audio_capture);
+    const bool audio_active =
+      (persistent_state.active_fields & audio_fields) != sbar_field_none;
+    if (audio_active) {
+        persistent_state.event_driven_collectors =
+          static_cast<sbar::collector_t>(
+            persistent_state.event_driven_collectors
+            | sbar::collector_sound_mixer);
+    }
+
+    // Network interfaces are re-enumerated and their states refreshed when
+    // the kernel reports a link change.
+    std::optional<sbar::network_monitor_t> network_monitor;
+    if ((persistent_state.active_fields & sbar_field_network)
+      != sbar_field_none) {
+        auto monitor = sbar::get_network_monitor();
+        if (monitor.has_value()) {
+            network_monitor.emplace(std::move(monitor.value()));
+            persistent_state.network_monitor = &network_monitor.value();
+            persistent_state.event_driven_collectors =
+              static_cast<sbar::collector_t>(
+                persistent_state.event_driven_collectors
+                | sbar::collector_network_interfaces);
+        } else {
+            std::cerr << monitor.error() << std::endl;
+        }
+    }
+
+    // Devices are re-enumerated when the kernel reports that they were added
+    // or removed instead of on every collection.
+    std::optional<sbar::device_monitor_t> device_monitor;
+    if ((persistent_state.active_fields
+          & sbar::get_dependent_fields(sbar::device_monitor_t::collectors))
+      != sbar_field_none) {
+        auto monitor = sbar::get_device_monitor();
+        if (monitor.has_value()) {
+            device_monitor.emplace(std::move(monitor.value()));
+            persistent_state.event_driven_collectors =
+              static_cast<sbar::collector_t>(
+                persistent_state.event_driven_collectors
+                | sbar::device_monitor_t::collectors);
+        } else {
+            std::cerr << monitor.error() << std::endl;
+        }
+    }
+
+    // The installed kernels are gathered again when a kernel is installed or
+    // removed instead of periodically.
+    std::optional<sbar::file_watcher_t> kernel_watcher;
+    if ((persistent_state.active_fields & sbar_field_outdated_kernel)
+      != sbar_field_none) {
+        auto watcher = sbar::get_file_watcher();
+        if (watcher.has_value()) {
+            bool watching = false;
+            for (const auto* path :
+              { "/usr/lib/modules", "/lib/modules", "/boot" }) {
+                if (! std::filesystem::is_directory(path)) {
+                    continue;
+                }
+                auto watch_result = watcher->watch(path,
+                  IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+                if (watch_result.failure()) {
+                    std::cerr << watch_result.error() << std::endl;
+                    continue;
+                }
+                watching = true;
+            }
+            if (watching) {
+                kernel_watcher.emplace(std::move(watcher.value()));
+                persistent_state.event_driven_collectors =
+                  static_cast<sbar::collector_t>(
+                    persistent_state.event_driven_collectors
+                    | sbar::collector_installed_kernels);
+            }
+        } else {
+            std::cerr << watcher.error() << std::endl;
+        }
+    }
+
+    // Refresh intervals of the top-level fields indexed by field index.
+    std::vector<sbar::scheduler_t::interval_t> intervals(
+      sbar_total_fields, default_interval);
+    intervals.at(__builtin_ctzll(sbar_field_username)) =
+      sbar::scheduler_t::once;
+    intervals.at(__builtin_ctzll(sbar_field_kernel)) = sbar::scheduler_t::once;
+    intervals.at(__builtin_ctzll(sbar_field_outdated_kernel)) =
+      kernel_watcher.has_value() ? sbar::scheduler_t::once : ch::minutes(1);
+    if (audio_active) {
+        intervals.at(__builtin_ctzll(sbar_field_audio_playback)) =
+          sbar::scheduler_t::once;
+        intervals.at(__builtin_ctzll(sbar_field_audio_capture)) =
+          sbar::scheduler_t::once;
+    }
+    const auto network_stat_fields =
+      static_cast<sbar_field_t>(sbar_field_network_packets_down
+        | sbar_field_network_packets_up | sbar_field_network_bytes_down
+        | sbar_field_network_bytes_up);
+    if (network_monitor.has_value()
+      && (persistent_state.network_fmt.fields & network_stat_fields)
+        == sbar_field_none
+      && ! uses_network_rates(persistent_state)) {
+        intervals.at(__builtin_ctzll(sbar_field_network)) =
+          sbar::scheduler_t::once;
+    }
+
+    if (argparser.is_used("--interval")) {
+        for (const auto& interval :
+          argparser.get<std::vector<std::string>>("--interval")) {
+            auto parsed = parse_interval(interval);
+            if (parsed.has_error()) {
+                std::cerr << parsed.error() << std::endl;
+                return 1;
+            }
+            intervals.at(__builtin_ctzll(parsed->first)) = parsed->second;
+        }
+    }
+
+    if (argparser.is_used("--quantize")) {
+        for (const auto& quantum :
+          argparser.get<std::vector<std::string>>("--quantize")) {
+            auto parsed = parse_value_filter(quantum);
+            if (parsed.has_error()) {
+                std::cerr << parsed.error() << std::endl;
+                return 1;
+            }
+            auto [format_field, field, number] = parsed.value();
+            persistent_state.value_filters[{ format_field, field }]
+              .set_quantum(number);
+        }
+    }
+
+    if (argparser.is_used("--hysteresis")) {
+        for (const auto& hysteresis :
+          argparser.get<std::vector<std::string>>("--hysteresis")) {
+            auto parsed = parse_value_filter(hysteresis);
+            if (parsed.has_error()) {
+                std::cerr << parsed.error() << std::endl;
+                return 1;
+            }
+            auto [format_field, field, number] = parsed.value();
+            persistent_state.value_filters[{ format_field, field }]
+              .set_hysteresis(number);
+        }
+    }
+
+    persistent_state.ignore_zero_capacity_disks = true;
+    persistent_state.mount_timeout =
+      ch::milliseconds(argparser.get<unsigned>("--mount-timeout"));
+    persistent_state.sparkline_width =
+      std::min<size_t>(argparser.get<unsigned>("--sparkline-width"),
+        sbar::history_t::capacity);
+
+    const auto per_core = argparser.get<std::string>("--per-core");
+    if (per_core == "glyphs") {
+        persistent_state.per_core_mode = per_core_mode_t::glyphs;
+    } else if (per_core != "values") {
+        const std::unordered_map<std::string, sbar::cpu_grouping_t>
+          groupings{
+              { "socket", sbar::cpu_grouping_t::socket },
+              { "cache", sbar::cpu_grouping_t::cache },
+              { "numa", sbar::cpu_grouping_t::numa },
+          };
+
+        auto grouping = groupings.find(per_core);
+        if (grouping == groupings.end()) {
+            std::cerr << "Invalid value of --per-core: " << per_core
+                      << std::endl;
+            return 1;
+        }
+
+        auto cpu_topology = sbar::get_cpu_topology(grouping->second);
+        if (cpu_topology.has_error()) {
+            std::cerr << cpu_topology.error() << std::endl;
+            return 1;
+        }
+
+        persistent_state.per_core_mode = per_core_mode_t::groups;
+        persistent_state.cpu_topology = std::move(cpu_topology.value());
+    }
+
+    auto channel = iipc::get_channel(sbar::channel);
+    if (channel.has_error()) {
+        std::cerr << channel.error() << std::endl;
         return 1;
     }
 
-    ch::milliseconds time_between_updates(1000);
-    ch::time_point time_at_last_update =
-      ch::system_clock::now() - time_between_updates;
+    auto root_window = sbar::get_root_window();
 
-    while (keep_running) {
-        auto time_elapsed = ch::system_clock::now() - time_at_last_update;
-        if (time_elapsed < time_between_updates) {
-            auto time_to_wait = ch::duration_cast<ch::milliseconds>(
-              time_between_updates - time_elapsed);
+    // The time is refreshed at aligned boundaries of the realtime clock so
+    // that every second is displayed exactly once. Everything else follows
+    // the monotonic clock.
+    auto clock_timer = sbar::get_timerfd(CLOCK_REALTIME);
+    if (clock_timer.has_error()) {
+        std::cerr << clock_timer.error() << std::endl;
+        return 1;
+    }
+
+    auto schedule_timer = sbar::get_timerfd(CLOCK_MONOTONIC);
+    if (schedule_timer.has_error()) {
+        std::cerr << schedule_timer.error() << std::endl;
+        return 1;
+    }
+
+    // Expires when the title may be updated again after a burst of changes.
+    auto frame_timer = sbar::get_timerfd(CLOCK_MONOTONIC);
+    if (frame_timer.has_error()) {
+        std::cerr << frame_timer.error() << std::endl;
+        return 1;
+    }
+
+    // Expires when the connection to the X server should be reopened.
+    auto reconnect_timer = sbar::get_timerfd(CLOCK_MONOTONIC);
+    if (reconnect_timer.has_error()) {
+        std::cerr << reconnect_timer.error() << std::endl;
+        return 1;
+    }
+
+    // Expires when the ALSA mixer should be opened again.
+    auto audio_timer = sbar::get_timerfd(CLOCK_MONOTONIC);
+    if (audio_timer.has_error()) {
+        std::cerr << audio_timer.error() << std::endl;
+        return 1;
+    }
+
+    // Expires when the fields of a refresh have taken too long to generate.
+    auto deadline_timer = sbar::get_timerfd(CLOCK_MONOTONIC);
+    if (deadline_timer.has_error()) {
+        std::cerr << deadline_timer.error() << std::endl;
+        return 1;
+    }
+
+    const auto time_interval = intervals.at(__builtin_ctzll(sbar_field_time));
+    const auto clock_period =
+      std::max(ch::ceil<ch::seconds>(time_interval), ch::seconds(1));
+    const bool clock_aligned =
+      (persistent_state.status_fmt.fields & sbar_field_time) != sbar_field_none
+      && time_interval != sbar::scheduler_t::once;
+
+    if (clock_aligned) {
+        auto set_result = clock_timer->set_aligned(clock_period);
+        if (set_result.failure()) {
+            std::cerr << set_result.error() << std::endl;
+            return 1;
+        }
+    }
+
+    sbar::scheduler_t scheduler;
+    for (size_t index = 0; index < sbar_total_fields; ++index) {
+        auto field = static_cast<sbar_field_t>(1ULL << index);
+        if ((field & persistent_state.status_fmt.fields) == sbar_field_none) {
+            continue;
+        }
+        if (field == sbar_field_time && clock_aligned) {
+            continue;
+        }
+        scheduler.add(field, intervals.at(index));
+    }
+
+    // inotify_ipc does not expose a file descriptor, so the channel is watched
+    // separately and drained whenever the event loop wakes.
+    auto channel_watcher = sbar::get_file_watcher();
+    if (channel_watcher.has_error()) {
+        std::cerr << channel_watcher.error() << std::endl;
+        return 1;
+    }
+
+    auto watch_result = channel_watcher->watch(sbar::channel,
+      IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch_result.failure()) {
+        std::cerr << watch_result.error() << std::endl;
+        return 1;
+    }
+
+    auto event_loop = sbar::get_event_loop();
+    if (event_loop.has_error()) {
+        std::cerr << event_loop.error() << std::endl;
+        return 1;
+    }
+
+    bool keep_running = true;
+
+    // Stop watching a file descriptor that failed. It would otherwise stay
+    // ready and wake the event loop on every pass.
+    auto unwatch = [&](int fd, const char* name) {
+        std::cerr << "Stopped watching the " << name << " after it failed."
+                  << std::endl;
+        auto remove_result = event_loop->remove(fd);
+        if (remove_result.failure()) {
+            std::cerr << remove_result.error() << std::endl;
+        }
+    };
+
+    auto add_result =
+      event_loop->add(signal_fd->get(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(signal_fd->get(), "signal file descriptor");
+              return;
+          }
+          auto signals = sbar::read_signals(signal_fd.value());
+          if (signals.has_error()) {
+              std::cerr << signals.error() << std::endl;
+              return;
+          }
+          if (sigismember(&signals.value(), SIGUSR1) == 1) {
+              report_title_updates(root_window);
+          }
+          if (sigismember(&signals.value(), SIGINT) == 1
+            || sigismember(&signals.value(), SIGTERM) == 1) {
+              keep_running = false;
+          }
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    add_result =
+      event_loop->add(clock_timer->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(clock_timer->fd(), "clock timer");
+              return;
+          }
+          auto clock_state = clock_timer->read();
+          if (clock_state.has_error()) {
+              std::cerr << clock_state.error() << std::endl;
+              return;
+          }
+          if (clock_state.value() == sbar::timerfd_t::state_t::pending) {
+              return;
+          }
+          if (clock_state.value() == sbar::timerfd_t::state_t::canceled) {
+              // The realtime clock was changed. Realign to the new time.
+              auto set_result = clock_timer->set_aligned(clock_period);
+              if (set_result.failure()) {
+                  std::cerr << set_result.error() << std::endl;
+              }
+          }
+          persistent_state.fields_to_update = static_cast<sbar_field_t>(
+            persistent_state.fields_to_update | sbar_field_time);
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    add_result =
+      event_loop->add(schedule_timer->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(schedule_timer->fd(), "schedule timer");
+              return;
+          }
+          // Due fields are taken from the scheduler after every wakeup.
+          auto schedule_state = schedule_timer->read();
+          if (schedule_state.has_error()) {
+              std::cerr << schedule_state.error() << std::endl;
+          }
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    add_result = event_loop->add(
+      channel_watcher->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(channel_watcher->fd(), "notification channel");
+              return;
+          }
+          // Notifications are received after every wakeup.
+          auto drain_result = channel_watcher->drain();
+          if (drain_result.has_error()) {
+              std::cerr << drain_result.error() << std::endl;
+          }
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<sbar::audio_monitor_t> audio_monitor;
+    std::vector<int> audio_fds;
+
+    // Stop watching the mixer and open it again after a delay. Jobs that
+    // still hold the monitor keep it alive until they finish.
+    auto close_audio_monitor = [&]() {
+        if (audio_monitor != nullptr) {
+            // Show that the audio fields are unavailable.
+            mark_stale(persistent_state, sbar::collector_sound_mixer);
+            persistent_state.fields_to_update = static_cast<sbar_field_t>(
+              persistent_state.fields_to_update | audio_fields);
+        }
+
+        for (int fd : audio_fds) {
+            auto remove_result = event_loop->remove(fd);
+            if (remove_result.failure()) {
+                std::cerr << remove_result.error() << std::endl;
+            }
+        }
+        audio_fds.clear();
+
+        audio_monitor.reset();
+        std::atomic_store(&persistent_state.audio_monitor,
+          std::shared_ptr<const sbar::audio_monitor_t>{});
+
+        auto set_result = audio_timer->set_deadline(
+          (sbar::scheduler_t::clock_t::now() + default_interval)
+            .time_since_epoch());
+        if (set_result.failure()) {
+            std::cerr << set_result.error() << std::endl;
+        }
+    };
+
+    auto open_audio_monitor = [&]() {
+        auto monitor = sbar::get_audio_monitor();
+        if (monitor.has_error()) {
+            std::cerr << monitor.error() << std::endl;
+            close_audio_monitor();
+            return;
+        }
+        audio_monitor =
+          std::make_shared<sbar::audio_monitor_t>(std::move(monitor.value()));
+
+        for (int fd : audio_monitor->fds()) {
+            auto audio_result =
+              event_loop->add(fd, EPOLLIN, [&](uint32_t events) {
+                  // The sound card was removed. Its descriptors stay ready,
+                  // so they must not be watched any longer.
+                  if (has_failed(events)) {
+                      std::cerr << "The ALSA mixer was disconnected."
+                                << std::endl;
+                      close_audio_monitor();
+                      return;
+                  }
+
+                  auto changed_fields = audio_monitor->handle_events();
+                  if (changed_fields.has_error()) {
+                      std::cerr << changed_fields.error() << std::endl;
+                      close_audio_monitor();
+                      return;
+                  }
+                  if (changed_fields.value() == sbar_field_none) {
+                      return;
+                  }
+                  mark_stale(persistent_state, sbar::collector_sound_mixer);
+                  persistent_state.fields_to_update =
+                    static_cast<sbar_field_t>(
+                      persistent_state.fields_to_update
+                      | changed_fields.value());
+              });
+            if (audio_result.failure()) {
+                std::cerr << audio_result.error() << std::endl;
+                close_audio_monitor();
+                return;
+            }
+            audio_fds.push_back(fd);
+        }
+
+        std::atomic_store(&persistent_state.audio_monitor,
+          std::shared_ptr<const sbar::audio_monitor_t>{ audio_monitor });
+        mark_stale(persistent_state, sbar::collector_sound_mixer);
+        persistent_state.fields_to_update = static_cast<sbar_field_t>(
+          persistent_state.fields_to_update | audio_fields);
+    };
+
+    add_result =
+      event_loop->add(audio_timer->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(audio_timer->fd(), "audio timer");
+              return;
+          }
+          auto audio_state = audio_timer->read();
+          if (audio_state.has_error()) {
+              std::cerr << audio_state.error() << std::endl;
+              return;
+          }
+          if (audio_state.value() == sbar::timerfd_t::state_t::expired) {
+              open_audio_monitor();
+          }
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    if (audio_active) {
+        open_audio_monitor();
+    }
+
+    // Sources that fail are no longer trusted to report their changes, so
+    // their collectors run on every collection and a field that was only
+    // generated once is refreshed periodically instead.
+    auto stop_event_driven = [&](sbar::collector_t collectors,
+                               sbar_field_t field,
+                               sbar::scheduler_t::interval_t interval) {
+        persistent_state.event_driven_collectors =
+          static_cast<sbar::collector_t>(
+            persistent_state.event_driven_collectors & ~collectors);
+        mark_stale(persistent_state, collectors);
+
+        if ((field & persistent_state.status_fmt.fields) != sbar_field_none
+          && intervals.at(__builtin_ctzll(field)) == sbar::scheduler_t::once) {
+            scheduler.add(field, interval);
+        }
+    };
+
+    auto lose_network_monitor = [&]() {
+        unwatch(network_monitor->fd(), "network monitor");
+        persistent_state.network_monitor = nullptr;
+        stop_event_driven(sbar::collector_network_interfaces,
+          sbar_field_network,
+          default_interval);
+    };
+
+    auto lose_device_monitor = [&]() {
+        unwatch(device_monitor->fd(), "device monitor");
+        stop_event_driven(sbar::device_monitor_t::collectors,
+          sbar_field_none,
+          default_interval);
+    };
+
+    auto lose_kernel_watcher = [&]() {
+        unwatch(kernel_watcher->fd(), "kernel watcher");
+        stop_event_driven(sbar::collector_installed_kernels,
+          sbar_field_outdated_kernel,
+          ch::minutes(1));
+    };
+
+    if (network_monitor.has_value()) {
+        add_result = event_loop->add(
+          network_monitor->fd(), EPOLLIN, [&](uint32_t events) {
+              // EPOLLERR reports dropped messages, which are handled by
+              // rebuilding the link table.
+              if ((events & EPOLLHUP) != 0) {
+                  lose_network_monitor();
+                  return;
+              }
+              auto changes = network_monitor->handle_events();
+              if (changes.has_error()) {
+                  std::cerr << changes.error() << std::endl;
+                  lose_network_monitor();
+                  return;
+              }
+              if (changes.value() == sbar::network_monitor_t::change_none) {
+                  return;
+              }
+              if ((changes.value() & sbar::network_monitor_t::change_links)
+                != 0) {
+                  mark_stale(
+                    persistent_state, sbar::collector_network_interfaces);
+              }
+              persistent_state.fields_to_update = static_cast<sbar_field_t>(
+                persistent_state.fields_to_update | sbar_field_network);
+          });
+        if (add_result.failure()) {
+            std::cerr << add_result.error() << std::endl;
+            return 1;
+        }
+    }
+
+    if (device_monitor.has_value()) {
+        add_result = event_loop->add(
+          device_monitor->fd(), EPOLLIN, [&](uint32_t events) {
+              // EPOLLERR reports dropped events, which are handled by
+              // re-enumerating every device.
+              if ((events & EPOLLHUP) != 0) {
+                  lose_device_monitor();
+                  return;
+              }
+              auto device_events = device_monitor->handle_events();
+              if (device_events.has_error()) {
+                  std::cerr << device_events.error() << std::endl;
+                  lose_device_monitor();
+                  return;
+              }
+              mark_stale(persistent_state, device_events->added_or_removed);
+              invalidate_attributes(
+                persistent_state, device_events->added_or_removed);
+              persistent_state.fields_to_update = static_cast<sbar_field_t>(
+                persistent_state.fields_to_update
+                | sbar::get_dependent_fields(static_cast<sbar::collector_t>(
+                  device_events->added_or_removed | device_events->changed)));
+          });
+        if (add_result.failure()) {
+            std::cerr << add_result.error() << std::endl;
+            return 1;
+        }
+    }
+
+    if (kernel_watcher.has_value()) {
+        add_result = event_loop->add(
+          kernel_watcher->fd(), EPOLLIN, [&](uint32_t events) {
+              if (has_failed(events)) {
+                  lose_kernel_watcher();
+                  return;
+              }
+              auto drain_result = kernel_watcher->drain();
+              if (drain_result.has_error()) {
+                  std::cerr << drain_result.error() << std::endl;
+                  return;
+              }
+              if (! drain_result.value()) {
+                  return;
+              }
+              mark_stale(persistent_state, sbar::collector_installed_kernels);
+              persistent_state.fields_to_update = static_cast<sbar_field_t>(
+                persistent_state.fields_to_update | sbar_field_outdated_kernel);
+          });
+        if (add_result.failure()) {
+            std::cerr << add_result.error() << std::endl;
+            return 1;
+        }
+    }
+
+    // Fields are generated on worker threads so that slow reads never hold
+    // up the title. The pool is declared after the persistent state so that
+    // its jobs finish before the state is destroyed.
+    auto worker_pool =
+      sbar::get_worker_pool(argparser.get<unsigned>("--workers"));
+    if (worker_pool.has_error()) {
+        std::cerr << worker_pool.error() << std::endl;
+        return 1;
+    }
+
+    const ch::milliseconds collector_deadline{ argparser.get<unsigned>(
+      "--collector-deadline") };
+    const auto stale_marker = argparser.get<std::string>("--stale-marker");
+
+    // dirty fields that are due on their schedule
+    sbar_field_t scheduled_fields = sbar_field_none;
+
+    // fields and collectors owned by jobs that have not completed
+    sbar_field_t busy_fields = sbar_field_none;
+    unsigned busy_collectors = sbar::collector_none;
+
+    // busy fields whose previous values were marked as stale
+    sbar_field_t late_fields = sbar_field_none;
+
+    // whether the title is held back until the busy fields are generated
+    bool waiting_for_jobs = false;
+
+    // whether the status changed since the title was last set
+    bool render_pending = false;
+
+    const ch::milliseconds min_frame_interval{ argparser.get<unsigned>(
+      "--min-frame-interval") };
+    sbar::scheduler_t::time_point_t last_frame{};
+    bool frame_timer_armed = false;
+
+    add_result =
+      event_loop->add(frame_timer->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(frame_timer->fd(), "frame timer");
+              return;
+          }
+          auto frame_state = frame_timer->read();
+          if (frame_state.has_error()) {
+              std::cerr << frame_state.error() << std::endl;
+              return;
+          }
+          if (frame_state.value() == sbar::timerfd_t::state_t::expired) {
+              frame_timer_armed = false;
+          }
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    // The connection to the X server is opened, and reopened after it is
+    // lost, with increasing delays so that the status bar survives X server
+    // restarts and waits for an X server that is not running yet.
+    auto lose_root_window = [&]() {
+        auto remove_result = event_loop->remove(root_window.fd());
+        if (remove_result.failure()) {
+            std::cerr << remove_result.error() << std::endl;
+        }
+
+        root_window.disconnect();
+
+        auto set_result = reconnect_timer->set_deadline(
+          root_window.next_reconnect().time_since_epoch());
+        if (set_result.failure()) {
+            std::cerr << set_result.error() << std::endl;
+        }
+    };
+
+    auto watch_root_window = [&]() {
+        return event_loop->add(
+          root_window.fd(), EPOLLIN, [&](uint32_t events) {
+              if (has_failed(events)) {
+                  std::cerr << "Lost the connection to the X server."
+                            << std::endl;
+                  lose_root_window();
+                  return;
+              }
+              auto events_result = root_window.handle_events();
+              if (events_result.failure()) {
+                  std::cerr << events_result.error() << std::endl;
+                  lose_root_window();
+              }
+          });
+    };
+
+    auto reconnect_root_window = [&]() {
+        auto reconnect_result = root_window.reconnect();
+        if (reconnect_result.failure()) {
+            std::cerr << reconnect_result.error() << std::endl;
+            auto set_result = reconnect_timer->set_deadline(
+              root_window.next_reconnect().time_since_epoch());
+            if (set_result.failure()) {
+                std::cerr << set_result.error() << std::endl;
+            }
+            return;
+        }
+
+        auto watch_result = watch_root_window();
+        if (watch_result.failure()) {
+            std::cerr << watch_result.error() << std::endl;
+            lose_root_window();
+        }
+    };
+
+    add_result =
+      event_loop->add(reconnect_timer->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(reconnect_timer->fd(), "reconnect timer");
+              return;
+          }
+          auto reconnect_state = reconnect_timer->read();
+          if (reconnect_state.has_error()) {
+              std::cerr << reconnect_state.error() << std::endl;
+              return;
+          }
+          if (reconnect_state.value() == sbar::timerfd_t::state_t::expired) {
+              reconnect_root_window();
+          }
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    reconnect_root_window();
+
+    add_result =
+      event_loop->add(worker_pool->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(worker_pool->fd(), "worker pool");
+          }
+          worker_pool->run_completions();
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    add_result =
+      event_loop->add(deadline_timer->fd(), EPOLLIN, [&](uint32_t events) {
+          if (has_failed(events)) {
+              unwatch(deadline_timer->fd(), "deadline timer");
+              return;
+          }
+          auto deadline_state = deadline_timer->read();
+          if (deadline_state.has_error()) {
+              std::cerr << deadline_state.error() << std::endl;
+              return;
+          }
+          if (deadline_state.value() != sbar::timerfd_t::state_t::expired) {
+              return;
+          }
+
+          // Show the previous values of the fields that are still busy.
+          waiting_for_jobs = false;
+          if (stale_marker.empty()) {
+              return;
+          }
+          for (size_t index = 0; index < sbar_total_fields; ++index) {
+              auto field = static_cast<sbar_field_t>(1ULL << index);
+              if ((field & busy_fields & ~late_fields) == sbar_field_none) {
+                  continue;
+              }
+              render_pending |= persistent_state.status.set(index,
+                std::string{ persistent_state.status.get(index) }
+                  + stale_marker);
+          }
+          late_fields = busy_fields;
+      });
+    if (add_result.failure()) {
+        std::cerr << add_result.error() << std::endl;
+        return 1;
+    }
+
+    auto dispatch_jobs = [&]() {
+        // Only top-level fields are generated. Fields within sub-formats are
+        // generated with the field that expands them.
+        persistent_state.fields_to_update = static_cast<sbar_field_t>(
+          persistent_state.fields_to_update
+          & persistent_state.status_fmt.fields);
+
+        bool dispatched = false;
+
+        for (const auto& job : split_into_jobs(static_cast<sbar_field_t>(
+               persistent_state.fields_to_update & ~busy_fields))) {
+            // Never run a collector twice at once. The fields of this job
+            // are dispatched once the busy collectors are released.
+            if ((job.collectors & busy_collectors) != sbar::collector_none) {
+                continue;
+            }
+
+            // Event-driven collectors keep their previous results until
+            // they are marked stale.
+            auto collectors = static_cast<sbar::collector_t>(job.collectors
+              & ~(persistent_state.event_driven_collectors
+                & ~persistent_state.stale_collectors));
+            persistent_state.stale_collectors = static_cast<sbar::collector_t>(
+              persistent_state.stale_collectors & ~collectors);
+
+            auto job_scheduled_fields =
+              static_cast<sbar_field_t>(scheduled_fields & job.fields);
+            scheduled_fields =
+              static_cast<sbar_field_t>(scheduled_fields & ~job.fields);
+
+            busy_fields = static_cast<sbar_field_t>(busy_fields | job.fields);
+            busy_collectors |= job.collectors;
+            persistent_state.fields_to_update = static_cast<sbar_field_t>(
+              persistent_state.fields_to_update & ~job.fields);
+
+            worker_pool->submit([&, job, collectors, job_scheduled_fields]() {
+                auto result = run_job(
+                  persistent_state, job, collectors, job_scheduled_fields);
+
+                return [&, job, result = std::move(result)]() {
+                    for (size_t index = 0; index < result.values.size();
+                         ++index) {
+                        if (result.values.test(index)) {
+                            render_pending |= persistent_state.status.set(
+                              index, persistent_state.field_values.at(index));
+                        }
+                    }
 
-            auto poll_result = channel->poll(time_to_wait);
+                    busy_fields =
+                      static_cast<sbar_field_t>(busy_fields & ~job.fields);
+                    busy_collectors &= ~job.collectors;
+                    late_fields =
+                      static_cast<sbar_field_t>(late_fields & ~job.fields);
+
+                    // Failed collectors are retried on the next collection.
+                    mark_stale(persistent_state, result.failed_collectors);
+                };
+            });
+            dispatched = true;
+        }
+
+        if (dispatched) {
+            waiting_for_jobs = true;
+            auto set_result = deadline_timer->set_deadline(
+              (sbar::scheduler_t::clock_t::now() + collector_deadline)
+                .time_since_epoch());
+            if (set_result.failure()) {
+                std::cerr << set_result.error() << std::endl;
+            }
+        }
+    };
+
+    auto receive_notifications = [&]() {
+        while (true) {
+            auto poll_result = channel->poll(ch::milliseconds(0));
             if (poll_result.has_error()) {
                 std::cerr << poll_result.error() << std::endl;
-                continue;
+                return;
             }
             if (! poll_result.value()) {
-                continue;
+                return;
             }
 
+            // The remaining notifications are received after the next
+            // wakeup so that a failing channel cannot stall the loop.
             auto receive_result = channel->receive();
-            if (receive_result.has_value()) {
-                try {
-                    persistent_state.fields_to_update =
-                      static_cast<sbar_field_t>(
-                        std::stoull(receive_result.value()));
-                } catch (const invalid_argument& exception) {
-                    std::cerr << exception.what() << std::endl;
-                }
-            } else {
+            if (receive_result.has_error()) {
                 std::cerr << receive_result.error() << std::endl;
+                return;
             }
-        } else {
-            time_at_last_update = ch::system_clock::now();
-        }
-
-        const auto cpu_usage_fields =
-          static_cast<sbar_field_t>(sbar_field_cpu | sbar_field_cpu_per_core);
 
-        if ((persistent_state.fields_to_update & cpu_usage_fields) != 0) {
-            auto update_result = persistent_state.cpu_usage.update();
-            if (update_result.failure()) {
-                std::cerr << update_result.error() << std::endl;
+            const auto& notification = receive_result.value();
+            unsigned long long fields = 0;
+            auto [last, error] = std::from_chars(notification.data(),
+              notification.data() + notification.size(),
+              fields);
+            if (error != std::errc{}
+              || last != notification.data() + notification.size()) {
+                std::cerr
+                  << "Received an invalid notification.\n\tnotification: "
+                  << notification << std::endl;
+                continue;
             }
+
+            mark_stale(persistent_state,
+              sbar::get_collectors(static_cast<sbar_field_t>(fields)));
+            persistent_state.fields_to_update = static_cast<sbar_field_t>(
+              persistent_state.fields_to_update | fields);
         }
+    };
 
-        const auto system_info_fields = static_cast<sbar_field_t>(
-          sbar_field_uptime | sbar_field_swap | sbar_field_memory
-          | sbar_field_load_1 | sbar_field_load_5 | sbar_field_load_15);
+    persistent_state.fields_to_update =
+      clock_aligned ? sbar_field_time : sbar_field_none;
 
-        if ((persistent_state.fields_to_update & system_info_fields) != 0) {
-            auto system_state = syst::get_system_info();
-            if (system_state.has_value()) {
-                persistent_state.system_info = system_state.value();
-            } else {
-                persistent_state.system_info = std::nullopt;
-                std::cerr << system_state.error() << std::endl;
-            }
+    while (keep_running) {
+        auto now = sbar::scheduler_t::clock_t::now();
+        auto due_fields = scheduler.pop_due(now);
+        scheduled_fields =
+          static_cast<sbar_field_t>(scheduled_fields | due_fields);
+        persistent_state.fields_to_update = static_cast<sbar_field_t>(
+          persistent_state.fields_to_update | due_fields);
+
+        dispatch_jobs();
+        if (busy_fields == sbar_field_none) {
+            waiting_for_jobs = false;
         }
 
-        const auto sound_mixer_fields = static_cast<sbar_field_t>(
-          sbar_field_audio_playback | sbar_field_audio_capture);
-
-        if ((persistent_state.fields_to_update & sound_mixer_fields) != 0) {
-            auto sound_mixer = syst::get_sound_mixer();
-            if (sound_mixer.has_value()) {
-                persistent_state.sound_mixer.reset(sound_mixer.release());
+        // Hold the title back until every field of a refresh is generated or
+        // the deadline expires, and until the previous frame is old enough.
+        // Changes made in the meantime are shown together.
+        if (render_pending && ! waiting_for_jobs && ! frame_timer_armed) {
+            auto next_frame = last_frame + min_frame_interval;
+            if (sbar::scheduler_t::clock_t::now() >= next_frame) {
+                auto result =
+                  root_window.set_title(persistent_state.status.str());
+                if (result.failure()) {
+                    std::cerr << result.error() << std::endl;
+                    lose_root_window();
+                }
+                render_pending = false;
+                last_frame = sbar::scheduler_t::clock_t::now();
             } else {
-                persistent_state.sound_mixer = nullptr;
-                std::cerr << sound_mixer.error() << std::endl;
+                auto set_result =
+                  frame_timer->set_deadline(next_frame.time_since_epoch());
+                if (set_result.failure()) {
+                    std::cerr << set_result.error() << std::endl;
+                } else {
+                    frame_timer_armed = true;
+                }
             }
         }
 
-        auto status = make_given_status(persistent_state.status_fmt,
-          true,
-          persistent_state,
-          status_field_assigner,
-          status_field_generator);
-        persistent_state.fields_to_update = sbar_field_all;
+        auto next_deadline = scheduler.next_deadline();
+        auto set_result = next_deadline.has_value()
+          ? schedule_timer->set_deadline(
+              next_deadline.value().time_since_epoch())
+          : schedule_timer->disarm();
+        if (set_result.failure()) {
+            std::cerr << set_result.error() << std::endl;
+        }
 
-        auto result = root_window->set_title(status);
-        if (result.failure()) {
-            std::cerr << result.error() << std::endl;
+        // Sleep until a timer expires, a job completes, a notification
+        // arrives, or a signal is received.
+        auto wait_result = event_loop->wait();
+        if (wait_result.failure()) {
+            std::cerr << wait_result.error() << std::endl;
         }
+
+        receive_notifications();
+    }
+
+    // A job blocked on an unresponsive device must not delay exiting, so the
+    // running jobs are waited for only briefly and the queued ones dropped.
+    const ch::milliseconds shutdown_timeout{ 1000 };
+    const bool workers_stopped = worker_pool->stop(shutdown_timeout);
+    if (! workers_stopped) {
+        std::cerr << "Some jobs did not finish before exiting." << std::endl;
     }
 
+    // Workers that are still running use the state of the status bar, so it
+    // is not destroyed if any of them were left behind.
+    auto exit_with = [&](int status) {
+        if (! workers_stopped) {
+            std::cout.flush();
+            std::_Exit(status);
+        }
+        return status;
+    };
+
     // Reset the title of the root window before exiting.
-    auto result = root_window->set_title("");
+    auto result = root_window.set_title("");
     if (result.failure()) {
         std::cerr << result.error() << std::endl;
-        return 1;
+        return exit_with(1);
     }
 
-    return 0;
+    report_title_updates(root_window);
+
+    return exit_with(0);
 }
@@ -0,0 +1,187 @@
+// Standard includes
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// External includes
+#include <sys/statvfs.h>
+
+// Local includes
+#include "mount_prober.hpp"
+
+namespace sbar {
+
+namespace {
+
+/**
+ * @brief Get the space of the filesystem mounted at a path with statvfs.
+ *
+ * @param[in] path - The path of the mount.
+ * @param[out] space - The space of the filesystem.
+ * @return 0 or an errno value.
+ */
+int probe_statvfs(const std::string& path, mount_prober_t::space_t& space) {
+    struct statvfs stat {};
+    if (statvfs(path.c_str(), &stat) < 0) {
+        return errno;
+    }
+
+    space = mount_prober_t::space_t{
+        static_cast<uint64_t>(stat.f_blocks) * stat.f_frsize,
+        static_cast<uint64_t>(stat.f_bavail) * stat.f_frsize,
+    };
+
+    return 0;
+}
+
+} // namespace
+
+mount_prober_t::mount_prober_t(probe_t probe) : probe_(std::move(probe)) {
+    if (! this->probe_) {
+        this->probe_ = probe_statvfs;
+    }
+}
+
+mount_prober_t::~mount_prober_t() {
+    for (auto& [path, prober] : this->probers_) {
+        stop(prober);
+    }
+}
+
+void mount_prober_t::stop(prober_t& prober) {
+    bool blocked = false;
+    {
+        std::lock_guard lock{ prober.mount->mutex };
+        prober.mount->stopping = true;
+        blocked = prober.mount->completed < prober.mount->requested;
+    }
+    prober.mount->changed.notify_all();
+
+    // A thread blocked on an unresponsive mount may never return. It shares
+    // ownership of its state, so it can safely outlive the prober.
+    if (blocked) {
+        prober.thread.detach();
+    } else {
+        prober.thread.join();
+    }
+}
+
+res::optional_t<std::shared_ptr<mount_prober_t::mount_t>>
+mount_prober_t::get_mount(const std::string& mount_path) {
+    std::lock_guard lock{ this->mutex_ };
+
+    auto prober = this->probers_.find(mount_path);
+    if (prober != this->probers_.end()) {
+        prober->second.used = true;
+        return prober->second.mount;
+    }
+
+    auto mount = std::make_shared<mount_t>();
+
+    std::thread thread;
+    try {
+        thread = std::thread{ [mount, probe = this->probe_, mount_path]() {
+            std::unique_lock mount_lock{ mount->mutex };
+
+            while (true) {
+                mount->changed.wait(mount_lock, [&mount]() {
+                    return mount->stopping
+                      || mount->completed < mount->requested;
+                });
+                if (mount->stopping) {
+                    return;
+                }
+
+                mount_lock.unlock();
+                space_t space{};
+                int error = probe(mount_path, space);
+                mount_lock.lock();
+
+                if (error == 0) {
+                    mount->space = space;
+                } else {
+                    mount->space.reset();
+                    mount->error = error;
+                }
+                mount->completed = mount->requested;
+                mount->late = false;
+                mount->changed.notify_all();
+            }
+        } };
+    } catch (const std::system_error& error) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to start a mount probe.\n\terror: " }
+          + error.what());
+    }
+
+    this->probers_.emplace(mount_path, prober_t{ mount, std::move(thread) });
+
+    return mount;
+}
+
+res::optional_t<mount_prober_t::space_t> mount_prober_t::get_space(
+  const std::filesystem::path& mount_path, std::chrono::milliseconds timeout) {
+    auto mount = this->get_mount(mount_path.string());
+    if (mount.has_error()) {
+        return RES_TRACE(mount.error());
+    }
+
+    auto& state = *mount.value();
+    std::unique_lock lock{ state.mutex };
+
+    bool busy = state.completed < state.requested;
+    if (busy && state.late) {
+        return RES_NEW_ERROR(
+          "Skipped probing an unresponsive mount: " + mount_path.string());
+    }
+
+    // A probe already in progress is shared instead of starting another.
+    if (! busy) {
+        ++state.requested;
+        state.changed.notify_all();
+    }
+    auto request = state.requested;
+
+    if (! state.changed.wait_for(lock, timeout, [&state, request]() {
+            return state.completed >= request;
+        })) {
+        state.late = true;
+        return RES_NEW_ERROR(
+          "Timed out probing a mount: " + mount_path.string());
+    }
+
+    if (! state.space.has_value()) {
+        return RES_NEW_ERROR("Failed to get the space of a mount: "
+          + mount_path.string() + "\n\terror: " + std::strerror(state.error));
+    }
+
+    return state.space.value();
+}
+
+void mount_prober_t::forget_unused() {
+    std::vector<prober_t> unused;
+    {
+        std::lock_guard lock{ this->mutex_ };
+
+        for (auto prober = this->probers_.begin();
+             prober != this->probers_.end();) {
+            if (prober->second.used) {
+                prober->second.used = false;
+                ++prober;
+                continue;
+            }
+            unused.push_back(std::move(prober->second));
+            prober = this->probers_.erase(prober);
+        }
+    }
+
+    // Threads are stopped without the lock so that probes of other mounts
+    // are not held up.
+    for (auto& prober : unused) {
+        stop(prober);
+    }
+}
+
+} // namespace sbar
@@ -0,0 +1,137 @@
+#pragma once
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+namespace sbar {
+
+/**
+ * @brief Gets the space of mounted filesystems without blocking on mounts
+ * that stopped responding (e.g. NFS or SSHFS mounts whose server is gone).
+ *
+ * Every mount is probed by its own long-lived thread that handles one
+ * request at a time. A mount whose probe times out is marked unresponsive
+ * and is not probed again until that probe returns. The threads of mounts
+ * that are no longer probed are stopped by forget_unused. Stopped threads are
+ * joined, except for threads still blocked on an unresponsive mount, which
+ * are detached so that nothing waits for the mount.
+ *
+ * @code{.cpp}
+ * mount_prober_t mount_prober;
+ *
+ * auto space =
+ *   mount_prober.get_space("/mnt/nfs", std::chrono::milliseconds(250));
+ * if (space.has_error()) {
+ *     // the mount is unresponsive or statvfs failed
+ * }
+ *
+ * // Stop probing mounts that were not probed since the last call.
+ * mount_prober.forget_unused();
+ * @endcode
+ */
+class mount_prober_t {
+  public:
+    /**
+     * @brief The space of a filesystem in bytes.
+     */
+    struct space_t {
+        uint64_t capacity;
+        uint64_t available; // available to unprivileged users
+    };
+
+    /**
+     * @brief Gets the space of the filesystem mounted at a path. Returns 0
+     * or an errno value.
+     */
+    using probe_t = std::function<int(const std::string& path, space_t&)>;
+
+  private:
+    // The state of one mount shared with the thread that probes it.
+    struct mount_t {
+        std::mutex mutex;
+        std::condition_variable changed;
+        uint64_t requested = 0; // requests made
+        uint64_t completed = 0; // requests answered
+        bool late = false;      // the current request timed out
+        bool stopping = false;
+        std::optional<space_t> space;
+        int error = 0;
+    };
+
+    struct prober_t {
+        std::shared_ptr<mount_t> mount;
+        std::thread thread;
+        bool used = true; // probed since forget_unused was last called
+    };
+
+    probe_t probe_;
+
+    std::mutex mutex_;
+
+    // probers by mount path
+    std::unordered_map<std::string, prober_t> probers_;
+
+    /**
+     * @brief Get the state of a mount, starting its prober thread if needed.
+     *
+     * @param[in] mount_path - The path of the mount.
+     */
+    [[nodiscard]] res::optional_t<std::shared_ptr<mount_t>> get_mount(
+      const std::string& mount_path);
+
+    /**
+     * @brief Stop the thread of a prober. The thread is joined unless it is
+     * blocked on an unresponsive mount, in which case it is detached.
+     *
+     * @param[in, out] prober - The prober to stop.
+     */
+    static void stop(prober_t& prober);
+
+  public:
+    /**
+     * @param[in] probe - Gets the space of a mount. Defaults to statvfs.
+     */
+    explicit mount_prober_t(probe_t probe = {});
+
+    mount_prober_t(const mount_prober_t&) = delete;
+    mount_prober_t(mount_prober_t&&) = delete;
+    mount_prober_t& operator=(const mount_prober_t&) = delete;
+    mount_prober_t& operator=(mount_prober_t&&) = delete;
+
+    ~mount_prober_t();
+
+    /**
+     * @brief Get the space of the filesystem mounted at a path. Safe to call
+     * from multiple threads. Concurrent calls for the same mount share one
+     * probe.
+     *
+     * @param[in] mount_path - The path of the mount.
+     * @param[in] timeout - How long to wait for the filesystem to respond.
+     * @return the space of the filesystem or an error if the mount is
+     * unresponsive or statvfs failed.
+     */
+    [[nodiscard]] res::optional_t<space_t> get_space(
+      const std::filesystem::path& mount_path,
+      std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Stop probing the mounts that were not probed since the previous
+     * call so that mounts that disappeared do not keep their threads.
+     */
+    void forget_unused();
+};
+
+} // namespace sbar
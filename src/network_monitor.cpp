@@ -0,0 +1,267 @@
+// Standard includes
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+// External includes
+#include <linux/if.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Local includes
+#include "network_monitor.hpp"
+
+namespace sbar {
+
+res::optional_t<network_monitor_t> get_network_monitor() {
+    int fd = socket(
+      AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to open a route netlink socket.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    network_monitor_t network_monitor{ fd_t{ fd } };
+
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK;
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to subscribe to link messages.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    auto request_result = network_monitor.request_links();
+    if (request_result.failure()) {
+        return RES_TRACE(request_result.error());
+    }
+
+    // Nothing reads the link table yet, so the first reply is waited for.
+    const int dump_timeout_ms = 1000;
+    while (! network_monitor.dump_done_) {
+        pollfd descriptor{ fd, POLLIN, 0 };
+        int ready = poll(&descriptor, 1, dump_timeout_ms);
+        if (ready < 0 && errno != EINTR) {
+            return RES_NEW_ERROR(
+              std::string{ "Failed to wait for the network links.\n\terror: " }
+              + std::strerror(errno));
+        }
+        if (ready == 0) {
+            return RES_NEW_ERROR("Timed out waiting for the network links.");
+        }
+
+        auto changes = network_monitor.receive();
+        if (changes.has_error()) {
+            return RES_TRACE(changes.error());
+        }
+    }
+
+    return network_monitor;
+}
+
+network_monitor_t::network_monitor_t(fd_t fd)
+: fd_(std::move(fd))
+, mutex_(std::make_unique<std::mutex>()) {
+}
+
+int network_monitor_t::fd() const {
+    return this->fd_.get();
+}
+
+res::optional_t<network_monitor_t::change_t>
+network_monitor_t::handle_events() {
+    std::lock_guard lock{ *this->mutex_ };
+
+    auto changes = this->receive();
+    if (changes.has_error()) {
+        return RES_TRACE(changes.error());
+    }
+
+    // Dropped messages may have changed any link, so every link is requested
+    // again. Only one dump may be in progress, so an overflow during a dump
+    // is handled once it is complete.
+    if (this->overflowed_ && this->dump_done_) {
+        this->overflowed_ = false;
+
+        auto request_result = this->request_links();
+        if (request_result.failure()) {
+            return RES_TRACE(request_result.error());
+        }
+    }
+
+    return static_cast<change_t>(changes.value());
+}
+
+res::result_t network_monitor_t::request_links() {
+    struct {
+        nlmsghdr header;
+        ifinfomsg info;
+    } request{};
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+    request.header.nlmsg_type = RTM_GETLINK;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.info.ifi_family = AF_UNSPEC;
+
+    if (send(this->fd_.get(), &request, request.header.nlmsg_len, 0) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to request the network links.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    this->dump_done_ = false;
+    this->dumped_.clear();
+
+    return res::success;
+}
+
+res::optional_t<unsigned> network_monitor_t::receive() {
+    const size_t buffer_size = 8192;
+    alignas(nlmsghdr) std::array<char, buffer_size> buffer{};
+
+    unsigned changes = change_none;
+
+    while (true) {
+        auto length = recv(this->fd_.get(), buffer.data(), buffer.size(), 0);
+        if (length < 0) {
+            if (errno == EAGAIN) {
+                break;
+            }
+            if (errno == ENOBUFS) {
+                // Messages were dropped. The link table must be rebuilt.
+                this->overflowed_ = true;
+                continue;
+            }
+            return RES_NEW_ERROR(
+              std::string{ "Failed to receive link messages.\n\terror: " }
+              + std::strerror(errno));
+        }
+
+        auto remaining = static_cast<unsigned int>(length);
+        for (auto* header = reinterpret_cast<nlmsghdr*>(buffer.data());
+             NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE) {
+                this->dump_done_ = true;
+                changes |= this->remove_undumped_links();
+                continue;
+            }
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                const auto* error =
+                  static_cast<const nlmsgerr*>(NLMSG_DATA(header));
+                return RES_NEW_ERROR(
+                  std::string{ "Received a link message error.\n\terror: " }
+                  + std::strerror(-error->error));
+            }
+            if (header->nlmsg_type != RTM_NEWLINK
+              && header->nlmsg_type != RTM_DELLINK) {
+                continue;
+            }
+
+            const auto* info =
+              static_cast<const ifinfomsg*>(NLMSG_DATA(header));
+
+            std::optional<std::string> name;
+            std::optional<unsigned char> operstate;
+
+            int attributes_length = IFLA_PAYLOAD(header);
+            for (const auto* attribute = IFLA_RTA(info);
+                 RTA_OK(attribute, attributes_length);
+                 attribute = RTA_NEXT(attribute, attributes_length)) {
+                if (attribute->rta_type == IFLA_IFNAME) {
+                    name = static_cast<const char*>(RTA_DATA(attribute));
+                } else if (attribute->rta_type == IFLA_OPERSTATE) {
+                    operstate =
+                      *static_cast<const unsigned char*>(RTA_DATA(attribute));
+                }
+            }
+
+            auto previous_name = this->names_.find(info->ifi_index);
+
+            if (header->nlmsg_type == RTM_DELLINK) {
+                this->dumped_.erase(info->ifi_index);
+                if (previous_name != this->names_.end()) {
+                    this->operstates_.erase(previous_name->second);
+                    this->names_.erase(previous_name);
+                    changes |= change_links;
+                }
+                continue;
+            }
+
+            if (! name.has_value()) {
+                continue;
+            }
+
+            if (! this->dump_done_) {
+                this->dumped_.insert(info->ifi_index);
+            }
+
+            if (previous_name == this->names_.end()) {
+                this->names_.emplace(info->ifi_index, name.value());
+                changes |= change_links;
+            } else if (previous_name->second != name.value()) {
+                this->operstates_.erase(previous_name->second);
+                previous_name->second = name.value();
+                changes |= change_links;
+            }
+
+            auto state = operstate.value_or(IF_OPER_UNKNOWN);
+            auto [entry, inserted] =
+              this->operstates_.try_emplace(name.value(), state);
+            if (! inserted && entry->second != state) {
+                entry->second = state;
+                changes |= change_state;
+            }
+        }
+    }
+
+    return changes;
+}
+
+unsigned network_monitor_t::remove_undumped_links() {
+    unsigned changes = change_none;
+
+    // Links removed while messages were dropped are missing from the dump.
+    for (auto name = this->names_.begin(); name != this->names_.end();) {
+        if (this->dumped_.count(name->first) != 0) {
+            ++name;
+            continue;
+        }
+        this->operstates_.erase(name->second);
+        name = this->names_.erase(name);
+        changes |= change_links;
+    }
+
+    return changes;
+}
+
+std::optional<network_monitor_t::link_state_t>
+network_monitor_t::get_link_state(const std::string& name) const {
+    std::lock_guard lock{ *this->mutex_ };
+
+    auto operstate = this->operstates_.find(name);
+    if (operstate == this->operstates_.end()) {
+        return std::nullopt;
+    }
+
+    switch (operstate->second) {
+        case IF_OPER_UP:
+            return link_state_t::up;
+        case IF_OPER_DORMANT:
+            return link_state_t::dormant;
+        case IF_OPER_DOWN:
+        case IF_OPER_LOWERLAYERDOWN:
+        case IF_OPER_NOTPRESENT:
+            return link_state_t::down;
+        default:
+            return link_state_t::unknown;
+    }
+}
+
+} // namespace sbar
@@ -0,0 +1,136 @@
+#pragma once
+
+// Standard includes
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+class network_monitor_t;
+
+/**
+ * @brief Return a new network monitor populated with the current network
+ * links or an error.
+ */
+[[nodiscard]] res::optional_t<network_monitor_t> get_network_monitor();
+
+/**
+ * @brief Keeps a table of network links and their operational states up to
+ * date by listening for link messages from the kernel (rtnetlink).
+ *
+ * @code{.cpp}
+ * auto network_monitor = get_network_monitor();
+ *
+ * event_loop->add(network_monitor->fd(), EPOLLIN, [&](uint32_t events) {
+ *     auto changes = network_monitor->handle_events();
+ *     // ...
+ * });
+ *
+ * auto state = network_monitor->get_link_state("eth0");
+ * @endcode
+ */
+class network_monitor_t {
+  public:
+    /**
+     * @brief The operational state of a link.
+     */
+    enum class link_state_t {
+        unknown, // the kernel does not track the state (IF_OPER_UNKNOWN)
+        up,      // IF_OPER_UP
+        dormant, // IF_OPER_DORMANT
+        down,    // IF_OPER_DOWN, IF_OPER_LOWERLAYERDOWN or IF_OPER_NOTPRESENT
+    };
+
+    /**
+     * @brief Changes to the link table reported by handle_events.
+     */
+    enum change_t : unsigned {
+        change_none = 0U,
+        change_state = 1U,               // the operational state of a link
+        change_links = change_state << 1, // a link was added or removed
+    };
+
+  private:
+    fd_t fd_;
+
+    // operational states (IF_OPER_*) by interface name
+    std::map<std::string, unsigned char> operstates_;
+
+    // interface names by interface index
+    std::map<int, std::string> names_;
+
+    bool dump_done_ = true;
+
+    // interface indices reported by the dump in progress
+    std::set<int> dumped_;
+
+    // whether link messages were dropped because the socket buffer was full
+    bool overflowed_ = false;
+
+    // Guards the link table, which is read from worker threads.
+    std::unique_ptr<std::mutex> mutex_;
+
+    network_monitor_t(fd_t fd);
+
+    friend res::optional_t<network_monitor_t> get_network_monitor();
+
+    /**
+     * @brief Apply every pending link message to the link table without
+     * blocking or locking.
+     *
+     * @return the changes made to the link table or an error.
+     */
+    [[nodiscard]] res::optional_t<unsigned> receive();
+
+    /**
+     * @brief Request every existing link without waiting for the reply. The
+     * reply is applied by receive, which removes the links missing from it
+     * once it is complete.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t request_links();
+
+    /**
+     * @brief Remove the links that were not reported by the completed dump.
+     *
+     * @return the changes made to the link table.
+     */
+    [[nodiscard]] unsigned remove_undumped_links();
+
+  public:
+    /**
+     * @brief Get the file descriptor of this monitor.
+     */
+    [[nodiscard]] int fd() const;
+
+    /**
+     * @brief Apply every pending link message to the link table without
+     * blocking. If messages were dropped, every link is requested again and
+     * the table is rebuilt from the reply as it arrives.
+     *
+     * @return the changes made to the link table or an error.
+     */
+    [[nodiscard]] res::optional_t<change_t> handle_events();
+
+    /**
+     * @brief Get the operational state of a link or std::nullopt if no link
+     * has the given name.
+     *
+     * @param[in] name - The name of the network interface.
+     */
+    [[nodiscard]] std::optional<link_state_t> get_link_state(
+      const std::string& name) const;
+};
+
+} // namespace sbar
@@ -0,0 +1,69 @@
+// Standard includes
+#include <cmath>
+#include <utility>
+
+// Local includes
+#include "number_format.hpp"
+
+namespace sbar {
+
+void append_fixed(std::string& output, double value, int precision) {
+    if (! std::isfinite(value)) {
+        output += std::isnan(value) ? "nan" : (value < 0 ? "-inf" : "inf");
+        return;
+    }
+
+    // Enough for the digits of any number below 10^300 with the precision
+    // used by the status bar.
+    std::array<char, 320> buffer{};
+    auto [last, error] = std::to_chars(buffer.data(),
+      buffer.data() + buffer.size(),
+      value,
+      std::chars_format::fixed,
+      precision);
+    if (error != std::errc{}) {
+        return;
+    }
+
+    output.append(buffer.data(), last);
+}
+
+void append_storage_size(std::string& output, uint64_t size) {
+    const uint64_t kibibyte = 1024;
+    const uint64_t mebibyte = kibibyte * 1024;
+    const uint64_t gibibyte = mebibyte * 1024;
+    const uint64_t tebibyte = gibibyte * 1024;
+    const uint64_t pebibyte = tebibyte * 1024;
+
+    const std::array<std::pair<uint64_t, char>, 5> units{ {
+      { pebibyte, 'P' },
+      { tebibyte, 'T' },
+      { gibibyte, 'G' },
+      { mebibyte, 'M' },
+      { kibibyte, 'K' },
+    } };
+
+    for (const auto& [unit, suffix] : units) {
+        if (size > unit) {
+            append_integer(output, size / unit);
+            output += suffix;
+            return;
+        }
+    }
+
+    append_integer(output, size);
+}
+
+std::string format_fixed(double value, int precision) {
+    std::string output;
+    append_fixed(output, value, precision);
+    return output;
+}
+
+std::string format_storage_size(uint64_t size) {
+    std::string output;
+    append_storage_size(output, size);
+    return output;
+}
+
+} // namespace sbar
@@ -0,0 +1,106 @@
+#pragma once
+
+// Standard includes
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace sbar {
+
+/**
+ * @brief Append an integer to a string. Does not allocate unless the string
+ * must grow.
+ *
+ * @code{.cpp}
+ * std::string status;
+ * append_integer(status, 7, 2); // "07"
+ * @endcode
+ *
+ * @param[in, out] output - The string to append to.
+ * @param[in] value - The integer.
+ * @param[in] width - The minimum number of digits. Shorter integers are
+ * padded with leading zeros.
+ */
+template<typename integer_t>
+void append_integer(std::string& output, integer_t value, int width = 0) {
+    static_assert(std::is_integral_v<integer_t>);
+
+    // Enough for the digits and sign of any 64-bit integer.
+    std::array<char, 24> buffer{};
+    char* begin = buffer.data();
+    char* end = buffer.data() + buffer.size();
+
+    if constexpr (std::is_signed_v<integer_t>) {
+        if (value < 0) {
+            output += '-';
+            // Negating the lowest integer would overflow.
+            auto magnitude = static_cast<std::make_unsigned_t<integer_t>>(
+              -static_cast<std::make_unsigned_t<integer_t>>(value));
+            append_integer(output, magnitude, width);
+            return;
+        }
+    }
+
+    auto [last, error] = std::to_chars(begin, end, value);
+    if (error != std::errc{}) {
+        return;
+    }
+
+    for (auto digits = last - begin; digits < width; ++digits) {
+        output += '0';
+    }
+    output.append(begin, last);
+}
+
+/**
+ * @brief Append a number with a fixed number of decimal places to a string.
+ * Does not allocate unless the string must grow.
+ *
+ * @param[in, out] output - The string to append to.
+ * @param[in] value - The number.
+ * @param[in] precision - The number of decimal places.
+ */
+void append_fixed(std::string& output, double value, int precision);
+
+/**
+ * @brief Append a size in bytes to a string in the largest binary unit
+ * (K, M, G, T or P) that it exceeds, rounded down. Does not allocate unless
+ * the string must grow.
+ *
+ * @param[in, out] output - The string to append to.
+ * @param[in] size - The size in bytes.
+ */
+void append_storage_size(std::string& output, uint64_t size);
+
+/**
+ * @brief Format an integer. Short results fit within the string itself, so
+ * they are not allocated.
+ *
+ * @param[in] value - The integer.
+ * @param[in] width - The minimum number of digits.
+ */
+template<typename integer_t>
+[[nodiscard]] std::string format_integer(integer_t value, int width = 0) {
+    std::string output;
+    append_integer(output, value, width);
+    return output;
+}
+
+/**
+ * @brief Format a number with a fixed number of decimal places.
+ *
+ * @param[in] value - The number.
+ * @param[in] precision - The number of decimal places.
+ */
+[[nodiscard]] std::string format_fixed(double value, int precision);
+
+/**
+ * @brief Format a size in bytes with a binary unit.
+ *
+ * @param[in] size - The size in bytes.
+ */
+[[nodiscard]] std::string format_storage_size(uint64_t size);
+
+} // namespace sbar
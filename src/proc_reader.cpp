@@ -0,0 +1,411 @@
+// Standard includes
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <utility>
+
+// External includes
+#include <fcntl.h>
+#include <unistd.h>
+
+// Local includes
+#include "proc_reader.hpp"
+
+namespace sbar {
+
+namespace {
+
+/**
+ * @brief Remove and return the first line of some text.
+ *
+ * @param[in, out] text - The remaining text.
+ */
+std::string_view next_line(std::string_view& text) {
+    auto end = text.find('\n');
+    auto line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    return line;
+}
+
+/**
+ * @brief Remove and return the first word of some text.
+ *
+ * @param[in, out] text - The remaining text.
+ */
+std::string_view next_word(std::string_view& text) {
+    auto begin = text.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        text = {};
+        return {};
+    }
+    text.remove_prefix(begin);
+
+    auto end = text.find(' ');
+    auto word = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end);
+    return word;
+}
+
+/**
+ * @brief Remove an unsigned integer from the start of some text.
+ *
+ * @param[in, out] text - The remaining text.
+ * @param[out] value - The integer.
+ * @return whether an integer was found.
+ */
+bool next_integer(std::string_view& text, uint64_t& value) {
+    auto word = next_word(text);
+    auto [last, error] =
+      std::from_chars(word.data(), word.data() + word.size(), value);
+    return error == std::errc{} && last == word.data() + word.size();
+}
+
+/**
+ * @brief Remove a decimal number such as "0.25" from the start of some text.
+ *
+ * @param[in, out] text - The remaining text.
+ * @param[out] value - The number.
+ * @return whether a number was found.
+ */
+bool next_decimal(std::string_view& text, double& value) {
+    auto word = next_word(text);
+    auto point = word.find('.');
+
+    uint64_t integer = 0;
+    auto integer_part = word.substr(0, point);
+    auto [integer_last, integer_error] = std::from_chars(integer_part.data(),
+      integer_part.data() + integer_part.size(),
+      integer);
+    if (integer_error != std::errc{}
+      || integer_last != integer_part.data() + integer_part.size()) {
+        return false;
+    }
+    value = static_cast<double>(integer);
+
+    if (point == std::string_view::npos) {
+        return true;
+    }
+
+    uint64_t fraction = 0;
+    auto fraction_part = word.substr(point + 1);
+    auto [fraction_last, fraction_error] = std::from_chars(
+      fraction_part.data(), fraction_part.data() + fraction_part.size(),
+      fraction);
+    if (fraction_error != std::errc{}
+      || fraction_last != fraction_part.data() + fraction_part.size()) {
+        return false;
+    }
+
+    double scale = 1;
+    for (size_t digit = 0; digit < fraction_part.size(); ++digit) {
+        scale *= 10;
+    }
+    value += static_cast<double>(fraction) / scale;
+
+    return true;
+}
+
+/**
+ * @brief Parse the times of a "cpu" line of /proc/stat.
+ *
+ * @param[in] text - The line following its first word.
+ */
+cpu_time_t parse_cpu_time(std::string_view text) {
+    // user nice system idle iowait irq softirq steal (guest time is already
+    // counted as user time). Older kernels omit the trailing fields.
+    std::array<uint64_t, 8> times{};
+    for (auto& time : times) {
+        if (! next_integer(text, time)) {
+            break;
+        }
+    }
+
+    uint64_t idle = times[3] + times[4];
+    uint64_t busy =
+      times[0] + times[1] + times[2] + times[5] + times[6] + times[7];
+
+    return cpu_time_t{ busy, busy + idle };
+}
+
+/**
+ * @brief Get a percentage of the time between two samples spent busy.
+ */
+double get_usage(const cpu_time_t& previous, const cpu_time_t& current) {
+    if (current.total <= previous.total || current.busy < previous.busy) {
+        return 0;
+    }
+
+    return 100 * static_cast<double>(current.busy - previous.busy)
+      / static_cast<double>(current.total - previous.total);
+}
+
+/**
+ * @brief Get the rate per second of a counter between two samples.
+ */
+double get_rate(
+  uint64_t previous, uint64_t current, std::chrono::duration<double> elapsed) {
+    if (current < previous || elapsed.count() <= 0) {
+        return 0;
+    }
+
+    return static_cast<double>(current - previous) / elapsed.count();
+}
+
+} // namespace
+
+res::result_t parse_proc_stat(std::string_view contents, proc_stat_t& stat) {
+    bool found_cpu = false;
+    size_t cores = 0;
+
+    while (! contents.empty()) {
+        auto line = next_line(contents);
+        auto key = next_word(line);
+
+        if (key == "cpu") {
+            stat.cpu = parse_cpu_time(line);
+            found_cpu = true;
+        } else if (key.size() > 3 && key.compare(0, 3, "cpu") == 0) {
+            if (cores < stat.cores.size()) {
+                stat.cores[cores] = parse_cpu_time(line);
+            } else {
+                stat.cores.push_back(parse_cpu_time(line));
+            }
+            ++cores;
+        } else if (key == "intr") {
+            // The total is followed by the count of every interrupt.
+            next_integer(line, stat.interrupts);
+        } else if (key == "ctxt") {
+            next_integer(line, stat.context_switches);
+        } else if (key == "procs_running") {
+            next_integer(line, stat.procs_running);
+        }
+    }
+
+    stat.cores.resize(cores);
+
+    if (! found_cpu) {
+        return RES_NEW_ERROR(
+          "Failed to find the processor times in /proc/stat");
+    }
+
+    return res::success;
+}
+
+res::optional_t<meminfo_t> parse_meminfo(std::string_view contents) {
+    meminfo_t meminfo;
+    bool found_total = false;
+    bool found_available = false;
+    uint64_t free = 0;
+
+    while (! contents.empty()) {
+        // <key>: <value> kB
+        auto line = next_line(contents);
+        auto key = next_word(line);
+
+        uint64_t value = 0;
+        if (! next_integer(line, value)) {
+            continue;
+        }
+
+        if (key == "MemTotal:") {
+            meminfo.total = value;
+            found_total = true;
+        } else if (key == "MemFree:") {
+            free = value;
+        } else if (key == "MemAvailable:") {
+            meminfo.available = value;
+            found_available = true;
+        } else if (key == "Cached:") {
+            meminfo.cached = value;
+        } else if (key == "Dirty:") {
+            meminfo.dirty = value;
+        } else if (key == "SwapTotal:") {
+            meminfo.swap_total = value;
+        } else if (key == "SwapFree:") {
+            meminfo.swap_free = value;
+        }
+    }
+
+    if (! found_total) {
+        return RES_NEW_ERROR(
+          "Failed to find the total memory in /proc/meminfo");
+    }
+
+    // Kernels older than 3.14 do not estimate the available memory.
+    if (! found_available) {
+        meminfo.available = free + meminfo.cached;
+    }
+
+    return meminfo;
+}
+
+res::optional_t<loadavg_t> parse_loadavg(std::string_view contents) {
+    // <1 minute> <5 minutes> <15 minutes> <running>/<total> <last pid>
+    loadavg_t loadavg;
+    if (! next_decimal(contents, loadavg.load_1)
+      || ! next_decimal(contents, loadavg.load_5)
+      || ! next_decimal(contents, loadavg.load_15)) {
+        return RES_NEW_ERROR("Failed to parse /proc/loadavg");
+    }
+
+    return loadavg;
+}
+
+proc_file_t::proc_file_t(std::filesystem::path path, size_t buffer_size)
+: path_(std::move(path))
+, buffer_(buffer_size) {
+}
+
+res::optional_t<std::string_view> proc_file_t::read() {
+    if (this->fd_.get() < 0) {
+        int fd = ::open(this->path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return RES_NEW_ERROR("Failed to open a file: "
+              + this->path_.string() + "\n\terror: " + std::strerror(errno));
+        }
+        this->fd_ = fd_t{ fd };
+    }
+
+    while (true) {
+        auto length = pread(
+          this->fd_.get(), this->buffer_.data(), this->buffer_.size(), 0);
+        if (length < 0) {
+            int error = errno;
+            this->fd_ = fd_t{};
+            return RES_NEW_ERROR("Failed to read a file: "
+              + this->path_.string() + "\n\terror: " + std::strerror(error));
+        }
+
+        // A full buffer may have cut the file short.
+        auto size = static_cast<size_t>(length);
+        if (size < this->buffer_.size()) {
+            return std::string_view{ this->buffer_.data(), size };
+        }
+
+        this->buffer_.resize(this->buffer_.size() * 2);
+    }
+}
+
+res::result_t cpu_usage_t::update(
+  std::string_view contents, clock_t::time_point now) {
+    std::swap(this->previous_, this->current_);
+
+    auto parse_result = parse_proc_stat(contents, this->current_);
+    if (parse_result.failure()) {
+        std::swap(this->previous_, this->current_);
+        return RES_TRACE(parse_result.error());
+    }
+
+    this->previous_time_ = this->current_time_;
+    this->current_time_ = now;
+    ++this->samples_;
+
+    // The first sample is compared with zero (the time since boot).
+    if (this->samples_ == 1) {
+        this->previous_ = proc_stat_t{};
+    }
+
+    this->total_ = get_usage(this->previous_.cpu, this->current_.cpu);
+
+    this->per_core_.resize(this->current_.cores.size());
+    for (size_t core = 0; core < this->current_.cores.size(); ++core) {
+        // Cores that came online since the previous sample have no times.
+        cpu_time_t previous;
+        if (core < this->previous_.cores.size()) {
+            previous = this->previous_.cores[core];
+        }
+        this->per_core_[core] = get_usage(previous, this->current_.cores[core]);
+    }
+
+    return res::success;
+}
+
+res::optional_t<double> cpu_usage_t::get_total() const {
+    if (this->samples_ == 0) {
+        return RES_NEW_ERROR("The processor usage has not been sampled.");
+    }
+
+    return this->total_;
+}
+
+const std::vector<double>& cpu_usage_t::get_per_core() const {
+    return this->per_core_;
+}
+
+double cpu_usage_t::get_context_switch_rate() const {
+    if (this->samples_ < 2) {
+        return 0;
+    }
+
+    return get_rate(this->previous_.context_switches,
+      this->current_.context_switches,
+      this->current_time_ - this->previous_time_);
+}
+
+double cpu_usage_t::get_interrupt_rate() const {
+    if (this->samples_ < 2) {
+        return 0;
+    }
+
+    return get_rate(this->previous_.interrupts,
+      this->current_.interrupts,
+      this->current_time_ - this->previous_time_);
+}
+
+uint64_t cpu_usage_t::get_procs_running() const {
+    return this->current_.procs_running;
+}
+
+res::optional_t<system_info_t> get_system_info(
+  proc_file_t& meminfo, proc_file_t& loadavg) {
+    system_info_t system_info;
+
+    // Unlike CLOCK_MONOTONIC, CLOCK_BOOTTIME includes time spent suspended.
+    timespec uptime{};
+    if (clock_gettime(CLOCK_BOOTTIME, &uptime) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to get the uptime.\n\terror: " }
+          + std::strerror(errno));
+    }
+    system_info.uptime = std::chrono::seconds(uptime.tv_sec);
+
+    auto loadavg_contents = loadavg.read();
+    if (loadavg_contents.has_error()) {
+        return RES_TRACE(loadavg_contents.error());
+    }
+    auto load = parse_loadavg(loadavg_contents.value());
+    if (load.has_error()) {
+        return RES_TRACE(load.error());
+    }
+    system_info.load_1 = load->load_1;
+    system_info.load_5 = load->load_5;
+    system_info.load_15 = load->load_15;
+
+    auto meminfo_contents = meminfo.read();
+    if (meminfo_contents.has_error()) {
+        return RES_TRACE(meminfo_contents.error());
+    }
+    auto memory = parse_meminfo(meminfo_contents.value());
+    if (memory.has_error()) {
+        return RES_TRACE(memory.error());
+    }
+    system_info.memory = memory.value();
+
+    if (memory->total > 0 && memory->available <= memory->total) {
+        system_info.ram_usage = 100
+          * static_cast<double>(memory->total - memory->available)
+          / static_cast<double>(memory->total);
+    }
+    if (memory->swap_total > 0 && memory->swap_free <= memory->swap_total) {
+        system_info.swap_usage = 100
+          * static_cast<double>(memory->swap_total - memory->swap_free)
+          / static_cast<double>(memory->swap_total);
+    }
+
+    return system_info;
+}
+
+} // namespace sbar
@@ -0,0 +1,202 @@
+#pragma once
+
+// Standard includes
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+/**
+ * @brief The time spent by a processor in jiffies.
+ */
+struct cpu_time_t {
+    uint64_t busy = 0;
+    uint64_t total = 0;
+};
+
+/**
+ * @brief The fields of /proc/stat used by the status bar.
+ */
+struct proc_stat_t {
+    cpu_time_t cpu;                // every core
+    std::vector<cpu_time_t> cores; // each online core
+    uint64_t interrupts = 0;       // since boot
+    uint64_t context_switches = 0; // since boot
+    uint64_t procs_running = 0;
+};
+
+/**
+ * @brief The fields of /proc/meminfo used by the status bar in kibibytes.
+ */
+struct meminfo_t {
+    uint64_t total = 0;
+    uint64_t available = 0;
+    uint64_t cached = 0;
+    uint64_t dirty = 0;
+    uint64_t swap_total = 0;
+    uint64_t swap_free = 0;
+};
+
+/**
+ * @brief The load averages of /proc/loadavg.
+ */
+struct loadavg_t {
+    double load_1 = 0;
+    double load_5 = 0;
+    double load_15 = 0;
+};
+
+/**
+ * @brief Parse the contents of /proc/stat without allocating once the cores
+ * of the destination have been sized.
+ *
+ * @param[in] contents - The contents of /proc/stat.
+ * @param[out] stat - The parsed fields.
+ * @return a result indicating success or failure.
+ */
+res::result_t parse_proc_stat(std::string_view contents, proc_stat_t& stat);
+
+/**
+ * @brief Parse the contents of /proc/meminfo or return an error.
+ *
+ * @param[in] contents - The contents of /proc/meminfo.
+ */
+[[nodiscard]] res::optional_t<meminfo_t> parse_meminfo(
+  std::string_view contents);
+
+/**
+ * @brief Parse the contents of /proc/loadavg or return an error.
+ *
+ * @param[in] contents - The contents of /proc/loadavg.
+ */
+[[nodiscard]] res::optional_t<loadavg_t> parse_loadavg(
+  std::string_view contents);
+
+/**
+ * @brief A file in /proc that is kept open and read again from the start
+ * with a single pread into a buffer that is reused by every read.
+ *
+ * @code{.cpp}
+ * proc_file_t proc_stat{ "/proc/stat" };
+ *
+ * auto contents = proc_stat.read();
+ * if (contents.has_error()) {
+ *     std::cerr << contents.error() << std::endl;
+ *     return 1;
+ * }
+ * @endcode
+ */
+class proc_file_t {
+    std::filesystem::path path_;
+    fd_t fd_;
+    std::vector<char> buffer_;
+
+  public:
+    /**
+     * @param[in] path - The path of the file. It is opened by the first
+     * read.
+     * @param[in] buffer_size - The initial size of the buffer. It grows when
+     * the file does not fit.
+     */
+    explicit proc_file_t(
+      std::filesystem::path path, size_t buffer_size = 4096);
+
+    /**
+     * @brief Read the entire file.
+     *
+     * @return a view of the contents that is valid until the next read or an
+     * error.
+     */
+    [[nodiscard]] res::optional_t<std::string_view> read();
+};
+
+/**
+ * @brief Turns consecutive samples of /proc/stat into the usage of each core
+ * and rates per second.
+ *
+ * The first sample is compared with the time since boot. Rates are zero
+ * until two samples have been taken.
+ */
+class cpu_usage_t {
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+  private:
+    proc_stat_t previous_;
+    proc_stat_t current_;
+    clock_t::time_point previous_time_;
+    clock_t::time_point current_time_;
+    size_t samples_ = 0;
+    double total_ = 0;
+    std::vector<double> per_core_;
+
+  public:
+    /**
+     * @brief Take a sample.
+     *
+     * @param[in] contents - The contents of /proc/stat.
+     * @param[in] now - The time at which /proc/stat was read.
+     * @return a result indicating success or failure.
+     */
+    res::result_t update(std::string_view contents, clock_t::time_point now);
+
+    /**
+     * @brief Get the usage of every core as a percentage or an error if no
+     * sample has been taken.
+     */
+    [[nodiscard]] res::optional_t<double> get_total() const;
+
+    /**
+     * @brief Get the usage of each online core as a percentage.
+     */
+    [[nodiscard]] const std::vector<double>& get_per_core() const;
+
+    /**
+     * @brief Get the number of context switches per second.
+     */
+    [[nodiscard]] double get_context_switch_rate() const;
+
+    /**
+     * @brief Get the number of interrupts per second.
+     */
+    [[nodiscard]] double get_interrupt_rate() const;
+
+    /**
+     * @brief Get the number of runnable processes.
+     */
+    [[nodiscard]] uint64_t get_procs_running() const;
+};
+
+/**
+ * @brief The memory usage, swap usage, load and uptime of the system.
+ */
+struct system_info_t {
+    std::chrono::seconds uptime{};
+    double load_1 = 0;
+    double load_5 = 0;
+    double load_15 = 0;
+    double ram_usage = 0;  // percent
+    double swap_usage = 0; // percent
+    meminfo_t memory;
+};
+
+/**
+ * @brief Read the system info from /proc/meminfo, /proc/loadavg and
+ * CLOCK_BOOTTIME or return an error.
+ *
+ * @param[in, out] meminfo - /proc/meminfo.
+ * @param[in, out] loadavg - /proc/loadavg.
+ */
+[[nodiscard]] res::optional_t<system_info_t> get_system_info(
+  proc_file_t& meminfo, proc_file_t& loadavg);
+
+} // namespace sbar
@@ -0,0 +1,120 @@
+#pragma once
+
+// Standard includes
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace sbar {
+
+/**
+ * @brief Turns cumulative counters (e.g. bytes received) into rates per
+ * second by keeping the previous sample of every device.
+ *
+ * Rates are computed from the monotonic time between two samples, so they
+ * stay correct however irregularly samples are taken. A counter that
+ * decreased (e.g. a device was reset) has a rate of zero.
+ *
+ * @code{.cpp}
+ * rate_tracker_t<2> rate_tracker;
+ *
+ * rate_tracker.sample("eth0", { bytes_down, bytes_up }, clock_t::now());
+ * // ...
+ * rate_tracker.sample("eth0", { bytes_down, bytes_up }, clock_t::now());
+ *
+ * auto rates = rate_tracker.get_rates("eth0"); // bytes per second
+ * @endcode
+ *
+ * @tparam counters - The number of counters sampled for each device.
+ */
+template<size_t counters>
+class rate_tracker_t {
+  public:
+    using clock_t = std::chrono::steady_clock;
+    using counters_t = std::array<uint64_t, counters>;
+    using rates_t = std::array<double, counters>;
+
+  private:
+    struct sample_t {
+        clock_t::time_point time;
+        counters_t values;
+        std::optional<rates_t> rates;
+    };
+
+    std::unordered_map<std::string, sample_t> samples_;
+
+  public:
+    /**
+     * @brief Record the counters of a device and compute its rates since its
+     * previous sample.
+     *
+     * @param[in] key - The name of the device.
+     * @param[in] values - The current values of the counters.
+     * @param[in] now - The time at which the counters were read.
+     */
+    void sample(const std::string& key,
+      const counters_t& values,
+      clock_t::time_point now) {
+        auto previous = this->samples_.find(key);
+        if (previous == this->samples_.end()) {
+            this->samples_.emplace(key, sample_t{ now, values, std::nullopt });
+            return;
+        }
+
+        auto& sample = previous->second;
+
+        std::chrono::duration<double> elapsed = now - sample.time;
+        if (elapsed.count() <= 0) {
+            return;
+        }
+
+        rates_t rates{};
+        for (size_t index = 0; index < counters; ++index) {
+            if (values[index] >= sample.values[index]) {
+                rates[index] =
+                  static_cast<double>(values[index] - sample.values[index])
+                  / elapsed.count();
+            }
+        }
+
+        sample = sample_t{ now, values, rates };
+    }
+
+    /**
+     * @brief Get the rates per second of a device or std::nullopt if it was
+     * sampled less than twice.
+     *
+     * @param[in] key - The name of the device.
+     */
+    [[nodiscard]] std::optional<rates_t> get_rates(
+      const std::string& key) const {
+        auto sample = this->samples_.find(key);
+        if (sample == this->samples_.end()) {
+            return std::nullopt;
+        }
+
+        return sample->second.rates;
+    }
+
+    /**
+     * @brief Forget the devices that were not sampled since a given time
+     * (e.g. devices that were removed).
+     *
+     * @param[in] time - The time of the oldest sample to keep.
+     */
+    void forget_before(clock_t::time_point time) {
+        for (auto sample = this->samples_.begin();
+             sample != this->samples_.end();) {
+            if (sample->second.time < time) {
+                sample = this->samples_.erase(sample);
+            } else {
+                ++sample;
+            }
+        }
+    }
+};
+
+} // namespace sbar
@@ -1,44 +1,300 @@
+// Standard includes
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
 // External includes
-#include <X11/Xlib.h>
+#include <xcb/xcb.h>
+#include <xcb/xcbext.h>
+#include <xcb/xproto.h>
 
 // Local includes
 #include "root_window.hpp"
 
 namespace sbar {
 
-res::optional_t<root_window_t> get_root_window() {
-    void* display = XOpenDisplay(nullptr);
-    if (display == nullptr) {
-        return RES_NEW_ERROR(
-          "Failed to get a handle to the root window running on the X server.");
+namespace {
+
+/**
+ * @brief Request an atom without waiting for the reply.
+ *
+ * @param[in] connection - The connection to the X server.
+ * @param[in] name - The name of the atom.
+ */
+xcb_intern_atom_cookie_t request_atom(
+  xcb_connection_t* connection, const char* name) {
+    return xcb_intern_atom(
+      connection, 0, static_cast<uint16_t>(std::strlen(name)), name);
+}
+
+/**
+ * @brief Collect the reply to an atom request without waiting for it.
+ *
+ * @param[in] connection - The connection to the X server.
+ * @param[in, out] request - The sequence number of the request or 0 if the
+ * reply was already collected. Set to 0 once the reply is collected.
+ * @param[out] atom - The atom.
+ * @return false if the request failed.
+ */
+bool poll_for_atom(
+  xcb_connection_t* connection, unsigned int& request, uint32_t& atom) {
+    if (request == 0) {
+        return true;
     }
 
-    return root_window_t{ display };
+    void* reply = nullptr;
+    xcb_generic_error_t* error = nullptr;
+    if (xcb_poll_for_reply(connection, request, &reply, &error) == 0) {
+        return true;
+    }
+    if (reply == nullptr) {
+        std::free(error);
+        return false;
+    }
+
+    atom = static_cast<xcb_intern_atom_reply_t*>(reply)->atom;
+    std::free(reply);
+    request = 0;
+
+    return true;
+}
+
+} // namespace
+
+root_window_t get_root_window() {
+    return root_window_t{ nullptr };
 }
 
-root_window_t::root_window_t(void* display) : display_(display) {
+root_window_t::root_window_t(void* connection) : connection_(connection) {
 }
 
 root_window_t::root_window_t(root_window_t&& root_window) noexcept
-: display_(root_window.display_) {
-    root_window.display_ = nullptr;
+: connection_(root_window.connection_)
+, root_(root_window.root_)
+, net_wm_name_(root_window.net_wm_name_)
+, utf8_string_(root_window.utf8_string_)
+, net_wm_name_request_(root_window.net_wm_name_request_)
+, utf8_string_request_(root_window.utf8_string_request_)
+, title_(std::move(root_window.title_))
+, has_title_(root_window.has_title_)
+, title_sent_(root_window.title_sent_)
+, backoff_(root_window.backoff_)
+, next_reconnect_(root_window.next_reconnect_)
+, published_updates_(root_window.published_updates_)
+, suppressed_updates_(root_window.suppressed_updates_) {
+    root_window.connection_ = nullptr;
 }
 
 root_window_t::~root_window_t() {
-    if (this->display_ != nullptr) {
-        XCloseDisplay(static_cast<Display*>(this->display_));
+    if (this->connection_ != nullptr) {
+        xcb_disconnect(static_cast<xcb_connection_t*>(this->connection_));
     }
 }
 
-res::result_t root_window_t::set_title(const std::string& title) {
-    Display* display = static_cast<Display*>(this->display_);
+res::result_t root_window_t::connect() {
+    int screen_number = 0;
+    xcb_connection_t* connection = xcb_connect(nullptr, &screen_number);
+
+    // A connection object is returned even on failure and must be freed.
+    if (xcb_connection_has_error(connection) != 0) {
+        xcb_disconnect(connection);
+        return RES_NEW_ERROR(
+          "Failed to get a handle to the root window running on the X server.");
+    }
+
+    auto screens = xcb_setup_roots_iterator(xcb_get_setup(connection));
+    for (int screen = 0; screen < screen_number && screens.rem > 0;
+         ++screen) {
+        xcb_screen_next(&screens);
+    }
+    if (screens.rem <= 0) {
+        xcb_disconnect(connection);
+        return RES_NEW_ERROR("Failed to find the default screen of the X "
+                             "server.\n\tscreen: "
+          + std::to_string(screen_number));
+    }
+
+    // The replies are collected by handle_events once they arrive.
+    auto net_wm_name_cookie = request_atom(connection, "_NET_WM_NAME");
+    auto utf8_string_cookie = request_atom(connection, "UTF8_STRING");
+    if (xcb_flush(connection) <= 0) {
+        xcb_disconnect(connection);
+        return RES_NEW_ERROR("Lost the connection to the X server.");
+    }
+
+    this->connection_ = connection;
+    this->root_ = screens.data->root;
+    this->net_wm_name_request_ = net_wm_name_cookie.sequence;
+    this->utf8_string_request_ = utf8_string_cookie.sequence;
+
+    return res::success;
+}
+
+res::result_t root_window_t::receive_atoms() {
+    auto* connection = static_cast<xcb_connection_t*>(this->connection_);
+
+    if (! poll_for_atom(
+          connection, this->net_wm_name_request_, this->net_wm_name_)
+      || ! poll_for_atom(
+        connection, this->utf8_string_request_, this->utf8_string_)) {
+        return RES_NEW_ERROR(
+          "Failed to get the atoms of the window title from the X server.");
+    }
+
+    if (! this->has_atoms()) {
+        return res::success;
+    }
+
+    // The connection is usable, so the next loss starts a new backoff.
+    this->backoff_ = initial_backoff;
+
+    if (this->has_title_) {
+        return this->send_title();
+    }
+
+    return res::success;
+}
+
+bool root_window_t::has_atoms() const {
+    return this->net_wm_name_request_ == 0 && this->utf8_string_request_ == 0;
+}
+
+res::result_t root_window_t::send_title() {
+    auto* connection = static_cast<xcb_connection_t*>(this->connection_);
+    auto length = static_cast<uint32_t>(this->title_.size());
+
+    // dwm reads WM_NAME. Other window managers and bars read _NET_WM_NAME.
+    xcb_change_property(connection,
+      XCB_PROP_MODE_REPLACE,
+      this->root_,
+      XCB_ATOM_WM_NAME,
+      XCB_ATOM_STRING,
+      8,
+      length,
+      this->title_.data());
+    xcb_change_property(connection,
+      XCB_PROP_MODE_REPLACE,
+      this->root_,
+      this->net_wm_name_,
+      this->utf8_string_,
+      8,
+      length,
+      this->title_.data());
+
+    // Neither request has a reply to wait for.
+    if (xcb_flush(connection) <= 0) {
+        return RES_NEW_ERROR("Lost the connection to the X server.");
+    }
+
+    this->title_sent_ = true;
+    ++this->published_updates_;
+
+    return res::success;
+}
+
+int root_window_t::fd() const {
+    if (this->connection_ == nullptr) {
+        return -1;
+    }
+
+    return xcb_get_file_descriptor(
+      static_cast<xcb_connection_t*>(this->connection_));
+}
+
+bool root_window_t::connected() const {
+    return this->connection_ != nullptr;
+}
+
+res::result_t root_window_t::handle_events() {
+    auto* connection = static_cast<xcb_connection_t*>(this->connection_);
+    if (connection == nullptr) {
+        return RES_NEW_ERROR("Not connected to the X server.");
+    }
+
+    // Errors caused by the title requests arrive as events too.
+    xcb_generic_event_t* event = nullptr;
+    while ((event = xcb_poll_for_event(connection)) != nullptr) {
+        std::free(event);
+    }
+
+    if (xcb_connection_has_error(connection) != 0) {
+        return RES_NEW_ERROR("Lost the connection to the X server.");
+    }
+
+    if (! this->has_atoms()) {
+        auto atoms_result = this->receive_atoms();
+        if (atoms_result.failure()) {
+            return RES_TRACE(atoms_result.error());
+        }
+    }
+
+    return res::success;
+}
 
-    if (XStoreName(display, DefaultRootWindow(display), title.data()) < 0) {
-        return RES_NEW_ERROR("Failed to set the title of the root window.");
+void root_window_t::disconnect() {
+    if (this->connection_ != nullptr) {
+        // A connection lost before its atoms arrived counts as a failed
+        // attempt to reconnect.
+        if (! this->has_atoms()) {
+            this->backoff_ = std::min(this->backoff_ * 2, maximum_backoff);
+        }
+
+        xcb_disconnect(static_cast<xcb_connection_t*>(this->connection_));
+        this->connection_ = nullptr;
+    }
+
+    this->net_wm_name_request_ = 0;
+    this->utf8_string_request_ = 0;
+
+    this->title_sent_ = false;
+    this->next_reconnect_ = clock_t::now() + this->backoff_;
+}
+
+root_window_t::clock_t::time_point root_window_t::next_reconnect() const {
+    return this->next_reconnect_;
+}
+
+res::result_t root_window_t::reconnect() {
+    if (this->connected()) {
+        return res::success;
+    }
+
+    auto connect_result = this->connect();
+    if (connect_result.failure()) {
+        this->backoff_ = std::min(this->backoff_ * 2, maximum_backoff);
+        this->next_reconnect_ = clock_t::now() + this->backoff_;
+        return RES_TRACE(connect_result.error());
     }
-    XFlush(display); // XFlush does not have a documented return value.
 
     return res::success;
 }
 
+res::result_t root_window_t::set_title(const std::string& title) {
+    // Every new title makes the window manager redraw its bar.
+    if (this->title_sent_ && title == this->title_) {
+        ++this->suppressed_updates_;
+        return res::success;
+    }
+
+    // Assigning reuses the capacity of the previous title.
+    this->title_ = title;
+    this->has_title_ = true;
+    this->title_sent_ = false;
+
+    if (! this->connected() || ! this->has_atoms()) {
+        return res::success;
+    }
+
+    return this->send_title();
+}
+
+size_t root_window_t::published_updates() const {
+    return this->published_updates_;
+}
+
+size_t root_window_t::suppressed_updates() const {
+    return this->suppressed_updates_;
+}
+
 } // namespace sbar
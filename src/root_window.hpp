@@ -1,6 +1,9 @@
 #pragma once
 
 // Standard includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 // External includes
@@ -11,45 +14,175 @@ namespace sbar {
 class root_window_t;
 
 /**
- * @brief Return a new root window object or an error.
+ * @brief Return a new root window object that is not connected to the X
+ * server yet. The first connection is opened by root_window_t::reconnect.
  */
-[[nodiscard]] res::optional_t<root_window_t> get_root_window();
+[[nodiscard]] root_window_t get_root_window();
 
 /**
  * @brief Used for interacting with the root window on the X server.
  *
+ * Nothing waits for the X server after the connection is opened. The atoms
+ * of the window title are collected by handle_events once their replies
+ * arrive, and titles are sent without waiting for replies. Until the
+ * connection is opened, and whenever it is lost, it is reopened with
+ * increasing delays and the current title is sent again.
+ *
  * @code{.cpp}
  * auto root_window = get_root_window();
- * if (root_window.failure()) {
- *     std::cerr << root_window.error() << std::endl;
- *     return 1;
+ *
+ * if (root_window.reconnect().success()) {
+ *     event_loop->add(root_window.fd(), EPOLLIN, [&](uint32_t events) {
+ *         if (root_window.handle_events().failure()) {
+ *             event_loop->remove(root_window.fd());
+ *             root_window.disconnect();
+ *             // Call reconnect at root_window.next_reconnect().
+ *         }
+ *     });
  * }
  *
- * root_window->set_title("New title for the root window");
+ * root_window.set_title("New title for the root window");
  * @endcode
  */
 class root_window_t {
-    void* display_; // Xlib Display
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    /**
+     * @brief The delay before the first attempt to reconnect.
+     */
+    static constexpr std::chrono::milliseconds initial_backoff{ 250 };
+
+    /**
+     * @brief The longest delay between attempts to reconnect.
+     */
+    static constexpr std::chrono::milliseconds maximum_backoff{ 30000 };
+
+  private:
+    void* connection_; // xcb_connection_t
+    uint32_t root_ = 0;
+    uint32_t net_wm_name_ = 0; // _NET_WM_NAME
+    uint32_t utf8_string_ = 0; // UTF8_STRING
+
+    // sequence numbers of the atom requests awaiting replies (0 once the
+    // atom is received)
+    unsigned int net_wm_name_request_ = 0;
+    unsigned int utf8_string_request_ = 0;
+
+    // the most recent title and whether it was sent on this connection
+    std::string title_;
+    bool has_title_ = false;
+    bool title_sent_ = false;
+
+    std::chrono::milliseconds backoff_ = initial_backoff;
+    clock_t::time_point next_reconnect_;
+
+    size_t published_updates_ = 0;
+    size_t suppressed_updates_ = 0;
+
+    root_window_t(void* connection);
 
-    root_window_t(void* display);
+    friend root_window_t get_root_window();
 
-    friend res::optional_t<root_window_t> get_root_window();
+    /**
+     * @brief Open a connection to the X server, look up the root window and
+     * request the atoms without waiting for their replies.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t connect();
+
+    /**
+     * @brief Collect the replies to the atom requests that have arrived and
+     * send the current title once every atom is known.
+     *
+     * @return a result indicating success or failure. A failure means that
+     * the connection is unusable.
+     */
+    res::result_t receive_atoms();
+
+    /**
+     * @brief Check whether every atom of the window title is known.
+     */
+    [[nodiscard]] bool has_atoms() const;
+
+    /**
+     * @brief Send the current title.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t send_title();
 
   public:
     root_window_t(const root_window_t&) = delete;
     root_window_t(root_window_t&&) noexcept;
     root_window_t& operator=(const root_window_t&) = delete;
-    root_window_t& operator=(root_window_t&&) noexcept = default;
+    root_window_t& operator=(root_window_t&&) noexcept = delete;
 
     ~root_window_t();
 
     /**
-     * @brief Set the title of the root window.
+     * @brief Get the file descriptor of the connection to the X server or
+     * -1 if disconnected.
+     */
+    [[nodiscard]] int fd() const;
+
+    /**
+     * @brief Check whether the connection to the X server is open.
+     */
+    [[nodiscard]] bool connected() const;
+
+    /**
+     * @brief Collect the replies to the atom requests and discard events
+     * received from the X server.
+     *
+     * @return a result indicating success or failure. A failure means that
+     * the connection was lost.
+     */
+    res::result_t handle_events();
+
+    /**
+     * @brief Close the connection to the X server and schedule an attempt to
+     * reconnect.
+     */
+    void disconnect();
+
+    /**
+     * @brief Get the time of the next attempt to reconnect.
+     */
+    [[nodiscard]] clock_t::time_point next_reconnect() const;
+
+    /**
+     * @brief Reopen the connection to the X server. The current title is sent
+     * by handle_events once the atoms are received. Each failure doubles the
+     * delay before the next attempt until the atoms are received.
      *
-     * @param[in] title - The new title represented as a string.
      * @return a result indicating success or failure.
      */
+    res::result_t reconnect();
+
+    /**
+     * @brief Set the title of the root window. Nothing is sent to the X
+     * server if the title is identical to the previous title. While
+     * disconnected, the title is sent once the connection is reopened and
+     * the atoms are received.
+     *
+     * @param[in] title - The new title represented as a string.
+     * @return a result indicating success or failure. A failure means that
+     * the connection was lost.
+     */
     res::result_t set_title(const std::string& title);
+
+    /**
+     * @brief Get the number of titles sent to the X server.
+     */
+    [[nodiscard]] size_t published_updates() const;
+
+    /**
+     * @brief Get the number of titles not sent to the X server because they
+     * were identical to the previous title.
+     */
+    [[nodiscard]] size_t suppressed_updates() const;
 };
 
 } // namespace sbar
@@ -0,0 +1,63 @@
+// Standard includes
+#include <algorithm>
+
+// Local includes
+#include "scheduler.hpp"
+
+namespace sbar {
+
+bool scheduler_t::later_(const entry_t& lhs, const entry_t& rhs) {
+    return lhs.deadline > rhs.deadline;
+}
+
+void scheduler_t::add(sbar_field_t fields, interval_t interval) {
+    auto now = clock_t::now();
+
+    for (auto& entry : this->heap_) {
+        if (entry.interval == interval && interval != once) {
+            entry.fields = static_cast<sbar_field_t>(entry.fields | fields);
+            entry.deadline = std::min(entry.deadline, now);
+            std::make_heap(this->heap_.begin(), this->heap_.end(), later_);
+            return;
+        }
+    }
+
+    this->heap_.push_back(entry_t{ now, interval, fields });
+    std::push_heap(this->heap_.begin(), this->heap_.end(), later_);
+}
+
+sbar_field_t scheduler_t::pop_due(time_point_t now) {
+    sbar_field_t fields = sbar_field_none;
+
+    while (! this->heap_.empty() && this->heap_.front().deadline <= now) {
+        std::pop_heap(this->heap_.begin(), this->heap_.end(), later_);
+        auto& entry = this->heap_.back();
+
+        fields = static_cast<sbar_field_t>(fields | entry.fields);
+
+        if (entry.interval == once) {
+            this->heap_.pop_back();
+            continue;
+        }
+
+        entry.deadline += entry.interval;
+        if (entry.deadline <= now) {
+            auto missed = (now - entry.deadline) / entry.interval;
+            entry.deadline += entry.interval * (missed + 1);
+        }
+
+        std::push_heap(this->heap_.begin(), this->heap_.end(), later_);
+    }
+
+    return fields;
+}
+
+std::optional<scheduler_t::time_point_t> scheduler_t::next_deadline() const {
+    if (this->heap_.empty()) {
+        return std::nullopt;
+    }
+
+    return this->heap_.front().deadline;
+}
+
+} // namespace sbar
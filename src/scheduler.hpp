@@ -0,0 +1,75 @@
+#pragma once
+
+// Standard includes
+#include <chrono>
+#include <optional>
+#include <vector>
+
+// Local includes
+#include "../include/notify.h"
+
+namespace sbar {
+
+/**
+ * @brief Decides when each field must be refreshed.
+ *
+ * Fields that share a refresh interval are grouped into a single entry of a
+ * min-heap ordered by the time at which they are next due.
+ *
+ * @code{.cpp}
+ * scheduler_t scheduler;
+ * scheduler.add(sbar_field_time, std::chrono::seconds(1));
+ * scheduler.add(sbar_field_kernel, scheduler_t::once);
+ *
+ * auto fields = scheduler.pop_due(scheduler_t::clock_t::now());
+ * @endcode
+ */
+class scheduler_t {
+  public:
+    using clock_t = std::chrono::steady_clock;
+    using time_point_t = clock_t::time_point;
+    using interval_t = std::chrono::milliseconds;
+
+    /**
+     * @brief An interval for fields that are only generated once.
+     */
+    static constexpr interval_t once{ 0 };
+
+  private:
+    struct entry_t {
+        time_point_t deadline;
+        interval_t interval;
+        sbar_field_t fields;
+    };
+
+    std::vector<entry_t> heap_;
+
+    static bool later_(const entry_t& lhs, const entry_t& rhs);
+
+  public:
+    /**
+     * @brief Schedule fields to be refreshed at a fixed interval. The fields
+     * are first due immediately.
+     *
+     * @param[in] fields - The fields to refresh.
+     * @param[in] interval - The time between refreshes or scheduler_t::once.
+     */
+    void add(sbar_field_t fields, interval_t interval);
+
+    /**
+     * @brief Remove and return every field that is due and schedule the next
+     * refresh of each periodic field. Refreshes missed by more than one
+     * interval are skipped rather than replayed.
+     *
+     * @param[in] now - The current time.
+     */
+    [[nodiscard]] sbar_field_t pop_due(time_point_t now);
+
+    /**
+     * @brief Get the time at which the next field is due or std::nullopt if
+     * no fields are scheduled.
+     */
+    [[nodiscard]] std::optional<time_point_t> next_deadline() const;
+};
+
+} // namespace sbar
@@ -0,0 +1,62 @@
+// Standard includes
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <string>
+
+// External includes
+#include <pthread.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+// Local includes
+#include "signals.hpp"
+
+namespace sbar {
+
+res::optional_t<fd_t> get_signal_fd(std::initializer_list<int> signals) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int signal : signals) {
+        sigaddset(&mask, signal);
+    }
+
+    // Signals must be blocked to be delivered through the file descriptor.
+    int block_result = pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    if (block_result != 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to block signals.\n\terror: " }
+          + std::strerror(block_result));
+    }
+
+    int fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to create a signal file descriptor.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return fd_t{ fd };
+}
+
+res::optional_t<sigset_t> read_signals(const fd_t& signal_fd) {
+    sigset_t signals;
+    sigemptyset(&signals);
+    signalfd_siginfo info{};
+
+    while (true) {
+        auto length = read(signal_fd.get(), &info, sizeof(info));
+        if (length == sizeof(info)) {
+            sigaddset(&signals, static_cast<int>(info.ssi_signo));
+            continue;
+        }
+        if (length < 0 && errno != EAGAIN) {
+            return RES_NEW_ERROR(
+              std::string{ "Failed to read signals.\n\terror: " }
+              + std::strerror(errno));
+        }
+        return signals;
+    }
+}
+
+} // namespace sbar
@@ -0,0 +1,41 @@
+#pragma once
+
+// Standard includes
+#include <csignal>
+#include <initializer_list>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+/**
+ * @brief Block the given signals for the calling thread (and any threads it
+ * creates afterwards) and return a non-blocking file descriptor from which
+ * they can be read (signalfd).
+ *
+ * @param[in] signals - The signals to receive (e.g. SIGINT).
+ */
+[[nodiscard]] res::optional_t<fd_t> get_signal_fd(
+  std::initializer_list<int> signals);
+
+/**
+ * @brief Consume every pending signal from a signal file descriptor.
+ *
+ * @code{.cpp}
+ * auto signals = read_signals(signal_fd);
+ * if (signals.has_value() && sigismember(&signals.value(), SIGTERM) == 1) {
+ *     keep_running = false;
+ * }
+ * @endcode
+ *
+ * @param[in] signal_fd - The file descriptor returned by get_signal_fd.
+ * @return the set of signals received (empty if none were pending) or an
+ * error.
+ */
+[[nodiscard]] res::optional_t<sigset_t> read_signals(const fd_t& signal_fd);
+
+} // namespace sbar
@@ -0,0 +1,60 @@
+// Local includes
+#include "status_buffer.hpp"
+
+namespace sbar {
+
+status_buffer_t::status_buffer_t(const format_t& format) {
+    for (const auto& segment : format.segments) {
+        if (segment.field == sbar_field_none) {
+            this->buffer_.append(
+              format.literals, segment.offset, segment.length);
+            continue;
+        }
+
+        this->slots_.push_back(
+          slot_t{ segment.index, this->buffer_.size(), 0 });
+    }
+}
+
+bool status_buffer_t::set(size_t index, std::string_view value) {
+    bool changed = false;
+    std::ptrdiff_t shift = 0;
+
+    for (auto& slot : this->slots_) {
+        slot.offset += shift;
+
+        if (slot.index != index) {
+            continue;
+        }
+
+        if (std::string_view{ this->buffer_ }.substr(slot.offset, slot.length)
+          == value) {
+            continue;
+        }
+
+        this->buffer_.replace(slot.offset, slot.length, value);
+        shift += static_cast<std::ptrdiff_t>(value.size())
+          - static_cast<std::ptrdiff_t>(slot.length);
+        slot.length = value.size();
+        changed = true;
+    }
+
+    return changed;
+}
+
+std::string_view status_buffer_t::get(size_t index) const {
+    for (const auto& slot : this->slots_) {
+        if (slot.index == index) {
+            return std::string_view{ this->buffer_ }.substr(
+              slot.offset, slot.length);
+        }
+    }
+
+    return {};
+}
+
+const std::string& status_buffer_t::str() const {
+    return this->buffer_;
+}
+
+} // namespace sbar
@@ -0,0 +1,62 @@
+#pragma once
+
+// Standard includes
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Local includes
+#include "format.hpp"
+
+namespace sbar {
+
+/**
+ * @brief A persistent status assembled from a compiled format.
+ *
+ * Literal text is written once. Every field segment owns a slot within the
+ * buffer that is patched in place when the value of its field changes.
+ *
+ * @code{.cpp}
+ * status_buffer_t status{ format };
+ * status.set(__builtin_ctzll(sbar_field_time), "2025-01-01 00:00:00");
+ * root_window->set_title(status.str());
+ * @endcode
+ */
+class status_buffer_t {
+    struct slot_t {
+        size_t index;
+        size_t offset;
+        size_t length;
+    };
+
+    std::string buffer_;
+    std::vector<slot_t> slots_;
+
+  public:
+    status_buffer_t() = default;
+    explicit status_buffer_t(const format_t& format);
+
+    /**
+     * @brief Replace the contents of every slot owned by a field.
+     *
+     * @param[in] index - The index of the field (see segment_t::index).
+     * @param[in] value - The new value of the field.
+     * @return true if the buffer changed and false otherwise.
+     */
+    bool set(size_t index, std::string_view value);
+
+    /**
+     * @brief Get the current value of a field or an empty view if the field
+     * does not appear in this status.
+     *
+     * @param[in] index - The index of the field (see segment_t::index).
+     */
+    [[nodiscard]] std::string_view get(size_t index) const;
+
+    /**
+     * @brief Get the entire status.
+     */
+    [[nodiscard]] const std::string& str() const;
+};
+
+} // namespace sbar
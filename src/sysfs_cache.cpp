@@ -0,0 +1,116 @@
+// Standard includes
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+// External includes
+#include <fcntl.h>
+#include <unistd.h>
+
+// Local includes
+#include "sysfs_cache.hpp"
+
+namespace sbar {
+
+res::optional_t<std::shared_ptr<sysfs_cache_t::entry_t>> sysfs_cache_t::open_(
+  const std::filesystem::path& path) {
+    std::lock_guard lock{ this->mutex_ };
+
+    auto entry = this->entries_.find(path.native());
+    if (entry != this->entries_.end()) {
+        return entry->second;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return RES_NEW_ERROR("Failed to open an attribute: " + path.string()
+          + "\n\terror: " + std::strerror(errno));
+    }
+
+    auto new_entry = std::make_shared<entry_t>();
+    new_entry->fd = fd_t{ fd };
+    this->entries_.emplace(path.native(), new_entry);
+
+    return new_entry;
+}
+
+void sysfs_cache_t::close_(const std::filesystem::path& path) {
+    std::lock_guard lock{ this->mutex_ };
+    this->entries_.erase(path.native());
+}
+
+res::optional_t<size_t> sysfs_cache_t::read_(
+  const std::filesystem::path& path, char* buffer, size_t size) {
+    auto entry = this->open_(path);
+    if (entry.has_error()) {
+        return RES_TRACE(entry.error());
+    }
+
+    auto length = pread(entry.value()->fd.get(), buffer, size, 0);
+    if (length < 0) {
+        int error = errno;
+        // The device may have been removed. Reopen the attribute next time.
+        this->close_(path);
+        return RES_NEW_ERROR("Failed to read an attribute: " + path.string()
+          + "\n\terror: " + std::strerror(error));
+    }
+
+    auto length_read = static_cast<size_t>(length);
+    while (length_read > 0 && buffer[length_read - 1] == '\n') {
+        --length_read;
+    }
+
+    return length_read;
+}
+
+res::result_t sysfs_cache_t::read(
+  const std::filesystem::path& path, std::string& contents) {
+    contents.resize(buffer_size);
+
+    auto length = this->read_(path, contents.data(), contents.size());
+    if (length.has_error()) {
+        contents.clear();
+        return RES_TRACE(length.error());
+    }
+
+    contents.resize(length.value());
+    return res::success;
+}
+
+res::optional_t<long long> sysfs_cache_t::read_integer(
+  const std::filesystem::path& path) {
+    std::array<char, buffer_size> buffer{};
+
+    auto length = this->read_(path, buffer.data(), buffer.size());
+    if (length.has_error()) {
+        return RES_TRACE(length.error());
+    }
+
+    long long integer = 0;
+    const auto* begin = buffer.data();
+    const auto* end = begin + length.value();
+    auto [last, error] = std::from_chars(begin, end, integer);
+    if (error != std::errc{} || last != end) {
+        return RES_NEW_ERROR("Failed to parse an attribute as an integer: "
+          + path.string() + "\n\tcontents: " + std::string(begin, end));
+    }
+
+    return integer;
+}
+
+void sysfs_cache_t::invalidate(const std::filesystem::path& directory) {
+    auto prefix = (directory / "").string();
+
+    std::lock_guard lock{ this->mutex_ };
+
+    for (auto entry = this->entries_.begin(); entry != this->entries_.end();) {
+        if (entry->first.rfind(prefix, 0) == 0) {
+            entry = this->entries_.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+}
+
+} // namespace sbar
@@ -0,0 +1,94 @@
+#pragma once
+
+// Standard includes
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+/**
+ * @brief Keeps sysfs attributes open and re-reads them from the start with
+ * a single pread instead of opening, reading and closing them every time.
+ *
+ * sysfs regenerates the contents of an attribute whenever it is read from
+ * offset zero, so an open attribute never goes stale. Attributes of removed
+ * devices fail to read and are reopened on the next read.
+ *
+ * @code{.cpp}
+ * sysfs_cache_t sysfs_cache;
+ *
+ * auto temperature =
+ *   sysfs_cache.read_integer("/sys/class/thermal/thermal_zone0/temp");
+ *
+ * // The buffer keeps its capacity between reads.
+ * std::string status;
+ * auto result =
+ *   sysfs_cache.read("/sys/class/power_supply/BAT0/status", status);
+ *
+ * // A device was removed.
+ * sysfs_cache.invalidate("/sys/class/power_supply");
+ * @endcode
+ */
+class sysfs_cache_t {
+    // Large enough for the statistics of a block device. Longer contents are
+    // truncated.
+    static constexpr size_t buffer_size = 256;
+
+    // Readers share the descriptor of an attribute. pread never moves the
+    // offset of the descriptor, so reads need no lock.
+    struct entry_t {
+        fd_t fd;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<entry_t>> entries_;
+
+    [[nodiscard]] res::optional_t<std::shared_ptr<entry_t>> open_(
+      const std::filesystem::path& path);
+
+    void close_(const std::filesystem::path& path);
+
+    [[nodiscard]] res::optional_t<size_t> read_(
+      const std::filesystem::path& path, char* buffer, size_t size);
+
+  public:
+    /**
+     * @brief Read an attribute without its trailing newline. Safe to call
+     * from multiple threads with different buffers.
+     *
+     * @param[in] path - The path of the attribute.
+     * @param[out] contents - Replaced with the contents of the attribute.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] res::result_t read(
+      const std::filesystem::path& path, std::string& contents);
+
+    /**
+     * @brief Read an attribute that holds a single integer. Safe to call from
+     * multiple threads.
+     *
+     * @param[in] path - The path of the attribute.
+     * @return the integer or an error.
+     */
+    [[nodiscard]] res::optional_t<long long> read_integer(
+      const std::filesystem::path& path);
+
+    /**
+     * @brief Close every open attribute within a directory.
+     *
+     * @param[in] directory - The directory whose attributes are closed.
+     */
+    void invalidate(const std::filesystem::path& directory);
+};
+
+} // namespace sbar
@@ -0,0 +1,126 @@
+// Standard includes
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// External includes
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Local includes
+#include "timer.hpp"
+
+namespace sbar {
+
+namespace {
+
+timespec to_timespec(std::chrono::nanoseconds duration) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+    return timespec{ static_cast<time_t>(seconds.count()),
+        static_cast<long>((duration - seconds).count()) };
+}
+
+std::chrono::nanoseconds from_timespec(const timespec& time) {
+    return std::chrono::seconds(time.tv_sec)
+      + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+} // namespace
+
+res::optional_t<timerfd_t> get_timerfd(clockid_t clock_id) {
+    int fd = timerfd_create(clock_id, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to create a timer.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return timerfd_t{ fd_t{ fd }, clock_id };
+}
+
+timerfd_t::timerfd_t(fd_t fd, clockid_t clock_id)
+: fd_(std::move(fd))
+, clock_id_(clock_id) {
+}
+
+int timerfd_t::fd() const {
+    return this->fd_.get();
+}
+
+res::result_t timerfd_t::set_deadline(std::chrono::nanoseconds deadline) {
+    // A zero deadline would disarm the timer.
+    if (deadline.count() <= 0) {
+        deadline = std::chrono::nanoseconds(1);
+    }
+
+    itimerspec spec{ timespec{ 0, 0 }, to_timespec(deadline) };
+
+    if (timerfd_settime(
+          this->fd_.get(), TFD_TIMER_ABSTIME, &spec, nullptr)
+      < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to set the deadline of a timer.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return res::success;
+}
+
+res::result_t timerfd_t::set_aligned(std::chrono::nanoseconds period) {
+    timespec now{};
+    if (clock_gettime(this->clock_id_, &now) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to get the current time.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    auto next = (from_timespec(now) / period + 1) * period;
+    itimerspec spec{ to_timespec(period), to_timespec(next) };
+
+    int flags = TFD_TIMER_ABSTIME;
+    if (this->clock_id_ == CLOCK_REALTIME) {
+        flags |= TFD_TIMER_CANCEL_ON_SET;
+    }
+
+    if (timerfd_settime(this->fd_.get(), flags, &spec, nullptr) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to set the period of a timer.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return res::success;
+}
+
+res::result_t timerfd_t::disarm() {
+    itimerspec spec{};
+
+    if (timerfd_settime(this->fd_.get(), 0, &spec, nullptr) < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to disarm a timer.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return res::success;
+}
+
+res::optional_t<timerfd_t::state_t> timerfd_t::read() {
+    uint64_t expirations = 0;
+
+    if (::read(this->fd_.get(), &expirations, sizeof(expirations)) < 0) {
+        if (errno == EAGAIN) {
+            return state_t::pending;
+        }
+        if (errno == ECANCELED) {
+            return state_t::canceled;
+        }
+        return RES_NEW_ERROR(
+          std::string{ "Failed to read a timer.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    return state_t::expired;
+}
+
+} // namespace sbar
@@ -0,0 +1,95 @@
+#pragma once
+
+// Standard includes
+#include <chrono>
+#include <ctime>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+class timerfd_t;
+
+/**
+ * @brief Return a new non-blocking timer driven by the given clock or an
+ * error.
+ *
+ * @param[in] clock_id - CLOCK_REALTIME or CLOCK_MONOTONIC.
+ */
+[[nodiscard]] res::optional_t<timerfd_t> get_timerfd(clockid_t clock_id);
+
+/**
+ * @brief A timer that is delivered through a file descriptor (timerfd).
+ *
+ * @code{.cpp}
+ * auto timer = get_timerfd(CLOCK_REALTIME);
+ * if (timer.failure()) {
+ *     std::cerr << timer.error() << std::endl;
+ *     return 1;
+ * }
+ *
+ * // Expire at the start of every second.
+ * timer->set_aligned(std::chrono::seconds(1));
+ * @endcode
+ */
+class timerfd_t {
+    fd_t fd_;
+    clockid_t clock_id_;
+
+    timerfd_t(fd_t fd, clockid_t clock_id);
+
+    friend res::optional_t<timerfd_t> get_timerfd(clockid_t clock_id);
+
+  public:
+    /**
+     * @brief The result of reading a timer.
+     */
+    enum class state_t {
+        pending,  // the timer has not expired since it was last read
+        expired,  // the timer expired at least once since it was last read
+        canceled, // the realtime clock was changed and the timer must be reset
+    };
+
+    /**
+     * @brief Get the file descriptor of this timer.
+     */
+    [[nodiscard]] int fd() const;
+
+    /**
+     * @brief Expire once at an absolute time on the clock of this timer.
+     *
+     * @param[in] deadline - The time since the epoch of the clock.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_deadline(std::chrono::nanoseconds deadline);
+
+    /**
+     * @brief Expire at every multiple of a period since the epoch of the
+     * clock of this timer. Realtime timers are canceled when the clock is
+     * changed.
+     *
+     * @param[in] period - The time between expirations.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_aligned(std::chrono::nanoseconds period);
+
+    /**
+     * @brief Stop this timer from expiring.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t disarm();
+
+    /**
+     * @brief Consume the expirations of this timer without blocking.
+     *
+     * @return the state of this timer or an error.
+     */
+    [[nodiscard]] res::optional_t<state_t> read();
+};
+
+} // namespace sbar
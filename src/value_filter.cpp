@@ -0,0 +1,36 @@
+// Standard includes
+#include <cmath>
+
+// Local includes
+#include "value_filter.hpp"
+
+namespace sbar {
+
+void value_filter_t::set_quantum(double quantum) {
+    this->quantum_ = quantum;
+}
+
+void value_filter_t::set_hysteresis(double hysteresis) {
+    this->hysteresis_ = hysteresis;
+}
+
+double value_filter_t::apply(double value, const std::string& device) {
+    if (this->hysteresis_ > 0) {
+        auto published = this->published_.find(device);
+        if (published == this->published_.end()) {
+            this->published_.emplace(device, value);
+        } else if (std::abs(value - published->second) < this->hysteresis_) {
+            value = published->second;
+        } else {
+            published->second = value;
+        }
+    }
+
+    if (this->quantum_ > 0) {
+        value = std::round(value / this->quantum_) * this->quantum_;
+    }
+
+    return value;
+}
+
+} // namespace sbar
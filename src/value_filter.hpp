@@ -0,0 +1,60 @@
+#pragma once
+
+// Standard includes
+#include <string>
+#include <unordered_map>
+
+namespace sbar {
+
+/**
+ * @brief Steadies a numeric field so that small fluctuations do not change
+ * the status.
+ *
+ * A value is published only once it differs from the previously published
+ * value by at least the hysteresis. The published value is then rounded to
+ * the nearest multiple of the quantum. Each device shown by a sub-format is
+ * tracked separately.
+ *
+ * @code{.cpp}
+ * value_filter_t filter;
+ * filter.set_quantum(2);
+ * filter.set_hysteresis(3);
+ *
+ * filter.apply(41.2); // 42
+ * filter.apply(43.9); // 42 (within 3 of 41.2)
+ * filter.apply(44.5); // 44
+ * @endcode
+ */
+class value_filter_t {
+    double quantum_ = 0;
+    double hysteresis_ = 0;
+
+    // the unrounded value most recently published for each device
+    std::unordered_map<std::string, double> published_;
+
+  public:
+    /**
+     * @brief Round published values to the nearest multiple of a quantum.
+     *
+     * @param[in] quantum - The quantum. Zero disables rounding.
+     */
+    void set_quantum(double quantum);
+
+    /**
+     * @brief Hold the published value until a value differs from it by at
+     * least a threshold.
+     *
+     * @param[in] hysteresis - The threshold. Zero publishes every value.
+     */
+    void set_hysteresis(double hysteresis);
+
+    /**
+     * @brief Get the value to publish for a new value.
+     *
+     * @param[in] value - The new value.
+     * @param[in] device - The device that the value belongs to, if any.
+     */
+    [[nodiscard]] double apply(double value, const std::string& device = {});
+};
+
+} // namespace sbar
@@ -0,0 +1,147 @@
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// External includes
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Local includes
+#include "worker_pool.hpp"
+
+namespace sbar {
+
+res::optional_t<worker_pool_t> get_worker_pool(size_t workers) {
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "Failed to create an event file descriptor.\n\terror: " }
+          + std::strerror(errno));
+    }
+
+    worker_pool_t worker_pool{ fd_t{ fd } };
+
+    auto shared = worker_pool.shared_;
+    for (size_t index = 0; index < std::max<size_t>(workers, 1); ++index) {
+        {
+            std::lock_guard lock{ shared->mutex };
+            ++shared->running_workers;
+        }
+        worker_pool.workers_.emplace_back(
+          [shared]() { worker_pool_t::work_(*shared); });
+    }
+
+    return worker_pool;
+}
+
+worker_pool_t::worker_pool_t(fd_t event_fd)
+: event_fd_(std::move(event_fd))
+, shared_(std::make_shared<shared_t>()) {
+    this->shared_->event_fd = this->event_fd_.get();
+}
+
+worker_pool_t::~worker_pool_t() {
+    if (this->shared_ == nullptr) {
+        return;
+    }
+
+    [[maybe_unused]] bool joined = this->stop(default_stop_timeout);
+}
+
+void worker_pool_t::work_(shared_t& shared) {
+    while (true) {
+        job_t job;
+        {
+            std::unique_lock lock{ shared.mutex };
+            shared.jobs_ready.wait(lock,
+              [&shared]() { return shared.stopping || ! shared.jobs.empty(); });
+            if (shared.stopping) {
+                --shared.running_workers;
+                shared.workers_done.notify_all();
+                return;
+            }
+            job = std::move(shared.jobs.front());
+            shared.jobs.pop_front();
+        }
+
+        auto completion = job();
+
+        // The event file descriptor is closed once the pool is stopped, so it
+        // is only written while the lock shows that the pool is running.
+        std::lock_guard lock{ shared.mutex };
+        if (shared.stopping) {
+            continue;
+        }
+        shared.completions.push_back(std::move(completion));
+
+        uint64_t count = 1;
+        // The counter can only fail to increase if it would overflow, in
+        // which case the file descriptor is already readable.
+        [[maybe_unused]] auto written =
+          write(shared.event_fd, &count, sizeof(count));
+    }
+}
+
+int worker_pool_t::fd() const {
+    return this->event_fd_.get();
+}
+
+void worker_pool_t::submit(job_t job) {
+    {
+        std::lock_guard lock{ this->shared_->mutex };
+        this->shared_->jobs.push_back(std::move(job));
+    }
+    this->shared_->jobs_ready.notify_one();
+}
+
+void worker_pool_t::run_completions() {
+    uint64_t count = 0;
+    [[maybe_unused]] auto read_bytes =
+      read(this->event_fd_.get(), &count, sizeof(count));
+
+    std::deque<completion_t> completions;
+    {
+        std::lock_guard lock{ this->shared_->mutex };
+        completions.swap(this->shared_->completions);
+    }
+
+    for (auto& completion : completions) {
+        if (completion) {
+            completion();
+        }
+    }
+}
+
+bool worker_pool_t::stop(std::chrono::milliseconds timeout) {
+    bool finished = false;
+    {
+        std::unique_lock lock{ this->shared_->mutex };
+        this->shared_->stopping = true;
+        this->shared_->jobs.clear();
+        this->shared_->completions.clear();
+        this->shared_->jobs_ready.notify_all();
+
+        finished = this->shared_->workers_done.wait_for(lock,
+          timeout,
+          [this]() { return this->shared_->running_workers == 0; });
+    }
+
+    // A worker blocked in a job may never return. It shares ownership of the
+    // shared state, so it can safely outlive the pool.
+    for (auto& worker : this->workers_) {
+        if (finished) {
+            worker.join();
+        } else {
+            worker.detach();
+        }
+    }
+    this->workers_.clear();
+
+    return finished;
+}
+
+} // namespace sbar
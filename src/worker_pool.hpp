@@ -0,0 +1,129 @@
+#pragma once
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "fd.hpp"
+
+namespace sbar {
+
+class worker_pool_t;
+
+/**
+ * @brief Return a new pool with a fixed number of worker threads or an error.
+ *
+ * @param[in] workers - The number of worker threads (at least one).
+ */
+[[nodiscard]] res::optional_t<worker_pool_t> get_worker_pool(size_t workers);
+
+/**
+ * @brief Runs jobs on a fixed set of worker threads and hands their results
+ * back to the thread that owns the pool.
+ *
+ * Every job returns a completion. Completions are queued when their jobs
+ * finish and run on the owning thread by run_completions, which is called
+ * when the file descriptor of the pool becomes readable.
+ *
+ * @code{.cpp}
+ * auto worker_pool = get_worker_pool(4);
+ *
+ * event_loop->add(worker_pool->fd(), EPOLLIN, [&](uint32_t events) {
+ *     worker_pool->run_completions();
+ * });
+ *
+ * worker_pool->submit([]() -> worker_pool_t::completion_t {
+ *     auto value = read_slow_device();
+ *     return [value]() { show(value); };
+ * });
+ * @endcode
+ */
+class worker_pool_t {
+  public:
+    using completion_t = std::function<void()>;
+    using job_t = std::function<completion_t()>;
+
+  private:
+    // Owned by the pool and the worker threads so that it survives moves and
+    // outlives the pool for workers that are detached while running a job.
+    struct shared_t {
+        std::mutex mutex;
+        std::condition_variable jobs_ready;
+        std::condition_variable workers_done;
+        std::deque<job_t> jobs;
+        std::deque<completion_t> completions;
+        size_t running_workers = 0;
+        bool stopping = false;
+        int event_fd = -1;
+    };
+
+    // How long destruction waits for the running jobs.
+    static constexpr std::chrono::milliseconds default_stop_timeout{ 1000 };
+
+    fd_t event_fd_;
+    std::shared_ptr<shared_t> shared_;
+    std::vector<std::thread> workers_;
+
+    worker_pool_t(fd_t event_fd);
+
+    static void work_(shared_t& shared);
+
+    friend res::optional_t<worker_pool_t> get_worker_pool(size_t workers);
+
+  public:
+    worker_pool_t(const worker_pool_t&) = delete;
+    worker_pool_t(worker_pool_t&&) noexcept = default;
+    worker_pool_t& operator=(const worker_pool_t&) = delete;
+    worker_pool_t& operator=(worker_pool_t&&) noexcept = delete;
+
+    /**
+     * @brief Stop the pool as stop does, waiting at most one second for the
+     * running jobs.
+     */
+    ~worker_pool_t();
+
+    /**
+     * @brief Get the file descriptor that becomes readable when completions
+     * are queued.
+     */
+    [[nodiscard]] int fd() const;
+
+    /**
+     * @brief Queue a job to be run on a worker thread.
+     *
+     * @param[in] job - The job to run. Its completion is run by
+     * run_completions.
+     */
+    void submit(job_t job);
+
+    /**
+     * @brief Run every queued completion on the calling thread.
+     */
+    void run_completions();
+
+    /**
+     * @brief Drop the queued jobs and wait for the running jobs to finish.
+     * Completions that were not run are discarded.
+     *
+     * A job blocked on an unresponsive device may never return, so worker
+     * threads still running a job after the timeout are detached. Their jobs
+     * may still use whatever they reference, so the caller must not release
+     * it (e.g. by returning from main) unless every worker was joined.
+     *
+     * @param[in] timeout - The longest time to wait for the running jobs.
+     * @return whether every worker thread finished and was joined.
+     */
+    [[nodiscard]] bool stop(std::chrono::milliseconds timeout);
+};
+
+} // namespace sbar
@@ -0,0 +1,116 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+
+// External includes
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+// Local includes
+#include "../src/cpu_topology.hpp"
+
+namespace {
+
+class cpu_topology_test : public testing::Test {
+  protected:
+    std::filesystem::path directory_;
+
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path()
+          / ("cpu_topology_test_" + std::to_string(getpid()));
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    void write(const std::filesystem::path& path, const std::string& value) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream{ path } << value;
+    }
+
+    void add_cpu(int cpu, int package, int node) {
+        auto cpu_directory = directory_ / ("cpu" + std::to_string(cpu));
+        write(cpu_directory / "topology" / "physical_package_id",
+          std::to_string(package) + "\n");
+        std::filesystem::create_directories(
+          cpu_directory / ("node" + std::to_string(node)));
+    }
+};
+
+} // namespace
+
+TEST_F(cpu_topology_test, cores_are_summarized_by_socket) {
+    write(directory_ / "online", "0-3\n");
+    add_cpu(0, 0, 0);
+    add_cpu(1, 1, 0);
+    add_cpu(2, 0, 0);
+    add_cpu(3, 1, 0);
+
+    auto topology =
+      sbar::get_cpu_topology(sbar::cpu_grouping_t::socket, directory_);
+    ASSERT_TRUE(topology.has_value());
+    EXPECT_EQ(topology->cores(), 4);
+    ASSERT_EQ(topology->groups(), 2);
+
+    std::vector<sbar::cpu_topology_t::summary_t> summaries;
+    ASSERT_TRUE(topology->summarize({ 10, 20, 30, 40 }, summaries).success());
+    ASSERT_EQ(summaries.size(), 2);
+    EXPECT_DOUBLE_EQ(summaries.at(0).lowest, 10);
+    EXPECT_DOUBLE_EQ(summaries.at(0).average, 20);
+    EXPECT_DOUBLE_EQ(summaries.at(0).highest, 30);
+    EXPECT_DOUBLE_EQ(summaries.at(1).lowest, 20);
+    EXPECT_DOUBLE_EQ(summaries.at(1).average, 30);
+    EXPECT_DOUBLE_EQ(summaries.at(1).highest, 40);
+}
+
+TEST_F(cpu_topology_test, offline_cores_are_skipped) {
+    write(directory_ / "online", "0,2-3\n");
+    add_cpu(0, 0, 1);
+    add_cpu(2, 0, 0);
+    add_cpu(3, 0, 1);
+
+    auto topology =
+      sbar::get_cpu_topology(sbar::cpu_grouping_t::numa, directory_);
+    ASSERT_TRUE(topology.has_value());
+    EXPECT_EQ(topology->cores(), 3);
+    ASSERT_EQ(topology->groups(), 2);
+
+    std::vector<sbar::cpu_topology_t::summary_t> summaries;
+    ASSERT_TRUE(topology->summarize({ 10, 50, 30 }, summaries).success());
+    EXPECT_DOUBLE_EQ(summaries.at(0).average, 50);
+    EXPECT_DOUBLE_EQ(summaries.at(1).average, 20);
+}
+
+TEST_F(cpu_topology_test, large_groups_are_summarized) {
+    write(directory_ / "online", "0-8\n");
+    for (int cpu = 0; cpu < 9; ++cpu) {
+        add_cpu(cpu, 0, 0);
+    }
+
+    auto topology =
+      sbar::get_cpu_topology(sbar::cpu_grouping_t::cache, directory_);
+    ASSERT_TRUE(topology.has_value());
+
+    std::vector<sbar::cpu_topology_t::summary_t> summaries;
+    ASSERT_TRUE(
+      topology->summarize({ 5, 1, 2, 3, 4, 9, 6, 7, 8 }, summaries).success());
+    ASSERT_EQ(summaries.size(), 1);
+    EXPECT_DOUBLE_EQ(summaries.at(0).lowest, 1);
+    EXPECT_DOUBLE_EQ(summaries.at(0).average, 5);
+    EXPECT_DOUBLE_EQ(summaries.at(0).highest, 9);
+}
+
+TEST_F(cpu_topology_test, changed_core_count_is_rejected) {
+    write(directory_ / "online", "0-1\n");
+    add_cpu(0, 0, 0);
+    add_cpu(1, 0, 0);
+
+    auto topology =
+      sbar::get_cpu_topology(sbar::cpu_grouping_t::socket, directory_);
+    ASSERT_TRUE(topology.has_value());
+
+    std::vector<sbar::cpu_topology_t::summary_t> summaries;
+    EXPECT_TRUE(topology->summarize({ 10, 20, 30 }, summaries).failure());
+}
@@ -0,0 +1,101 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/format.hpp"
+
+constexpr sbar_field_t test_extended_field = sbar::make_extended_field(1);
+
+sbar_field_t test_field_assigner(char token) {
+    switch (token) {
+        case 'T':
+            return sbar_field_time;
+        case 'U':
+            return sbar_field_uptime;
+        case 'E':
+            return test_extended_field;
+        default:
+            return sbar_field_none;
+    }
+}
+
+TEST(format_test, literals_and_fields_are_split_into_segments) {
+    auto format = sbar::compile_format("a /T b/U", test_field_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    ASSERT_EQ(format->segments.size(), 4);
+    EXPECT_EQ(format->segments.at(0).field, sbar_field_none);
+    EXPECT_EQ(format->literals.substr(
+                format->segments.at(0).offset, format->segments.at(0).length),
+      "a ");
+    EXPECT_EQ(format->segments.at(1).field, sbar_field_time);
+    EXPECT_EQ(format->segments.at(1).index, 0);
+    EXPECT_EQ(format->literals.substr(
+                format->segments.at(2).offset, format->segments.at(2).length),
+      " b");
+    EXPECT_EQ(format->segments.at(3).field, sbar_field_uptime);
+    EXPECT_EQ(format->segments.at(3).index, 1);
+    EXPECT_EQ(format->fields, sbar_field_time | sbar_field_uptime);
+}
+
+TEST(format_test, escaped_escape_sequence_is_a_literal) {
+    auto format = sbar::compile_format("a//b", test_field_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    ASSERT_EQ(format->segments.size(), 1);
+    EXPECT_EQ(format->literals, "a/b");
+    EXPECT_EQ(format->segments.at(0).length, 3);
+    EXPECT_EQ(format->fields, sbar_field_none);
+}
+
+TEST(format_test, invalid_token_is_rejected) {
+    auto format = sbar::compile_format("/T /X", test_field_assigner);
+    EXPECT_TRUE(format.has_error());
+}
+
+TEST(format_test, incomplete_escape_sequence_is_rejected) {
+    auto format = sbar::compile_format("/T /", test_field_assigner);
+    EXPECT_TRUE(format.has_error());
+}
+
+TEST(format_test, extended_fields_are_left_out_of_the_field_mask) {
+    auto format = sbar::compile_format("/E /T", test_field_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    ASSERT_EQ(format->segments.size(), 3);
+    EXPECT_EQ(format->segments.at(0).field, test_extended_field);
+    EXPECT_EQ(format->fields, sbar_field_time);
+    EXPECT_TRUE(sbar::has_field(format.value(), test_extended_field));
+    EXPECT_TRUE(sbar::has_field(format.value(), sbar_field_time));
+    EXPECT_FALSE(sbar::has_field(format.value(), sbar_field_uptime));
+}
+
+sbar_field_t test_history_assigner(char token) {
+    if (token == 'T') {
+        return sbar_field_time;
+    }
+    return sbar_field_none;
+}
+
+TEST(format_test, history_tokens_have_their_own_index) {
+    auto format = sbar::compile_format(
+      "/~T /T", test_field_assigner, test_history_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    ASSERT_EQ(format->segments.size(), 3);
+    EXPECT_TRUE(format->segments.at(0).history);
+    EXPECT_EQ(format->segments.at(0).field, sbar_field_time);
+    EXPECT_EQ(format->segments.at(0).index, sbar::history_index_offset);
+    EXPECT_FALSE(format->segments.at(2).history);
+    EXPECT_EQ(format->segments.at(2).index, 0);
+    EXPECT_EQ(format->fields, sbar_field_time);
+    EXPECT_EQ(format->history_fields, sbar_field_time);
+
+    EXPECT_TRUE(sbar::compile_format(
+      "/~U", test_field_assigner, test_history_assigner)
+                  .has_error());
+    EXPECT_TRUE(sbar::compile_format("/~T", test_field_assigner).has_error());
+    EXPECT_TRUE(sbar::compile_format(
+      "/~", test_field_assigner, test_history_assigner)
+                  .has_error());
+}
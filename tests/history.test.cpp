@@ -0,0 +1,46 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/history.hpp"
+
+TEST(history_test, empty_history_has_no_sparkline) {
+    sbar::history_t history;
+
+    EXPECT_EQ(history.size(), 0);
+    EXPECT_EQ(history.sparkline(10, 0, 100), "");
+}
+
+TEST(history_test, samples_are_scaled_to_the_given_range) {
+    sbar::history_t history;
+
+    history.push(0);
+    history.push(50);
+    history.push(100);
+    history.push(150);
+
+    EXPECT_EQ(history.sparkline(10, 0, 100), "▁▅██");
+}
+
+TEST(history_test, samples_are_scaled_to_themselves_by_default) {
+    sbar::history_t history;
+
+    history.push(20);
+    history.push(30);
+    history.push(40);
+
+    EXPECT_EQ(history.sparkline(10), "▁▅█");
+    EXPECT_EQ(history.sparkline(2), "▁█");
+}
+
+TEST(history_test, oldest_samples_are_replaced) {
+    sbar::history_t history;
+
+    for (size_t sample = 0; sample < sbar::history_t::capacity; ++sample) {
+        history.push(0);
+    }
+    history.push(100);
+
+    EXPECT_EQ(history.size(), sbar::history_t::capacity);
+    EXPECT_EQ(history.sparkline(3, 0, 100), "▁▁█");
+}
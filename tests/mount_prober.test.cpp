@@ -0,0 +1,150 @@
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/mount_prober.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Holds probes back until opened, like a mount that stopped
+ * responding.
+ */
+struct gate_t {
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool open = true;
+
+    void set_open(bool open) {
+        {
+            std::lock_guard lock{ this->mutex };
+            this->open = open;
+        }
+        this->changed.notify_all();
+    }
+
+    void pass() {
+        std::unique_lock lock{ this->mutex };
+        this->changed.wait(lock, [this]() { return this->open; });
+    }
+};
+
+/**
+ * @brief A probe that reports a fixed space once the gate is open and counts
+ * its calls.
+ */
+struct fake_mount_t {
+    std::shared_ptr<gate_t> gate = std::make_shared<gate_t>();
+    std::shared_ptr<std::atomic<int>> probes =
+      std::make_shared<std::atomic<int>>(0);
+
+    sbar::mount_prober_t::probe_t probe() const {
+        return [gate = this->gate, probes = this->probes](
+                 const std::string& /*path*/,
+                 sbar::mount_prober_t::space_t& space) {
+            ++*probes;
+            gate->pass();
+            space = sbar::mount_prober_t::space_t{ 1000, 250 };
+            return 0;
+        };
+    }
+};
+
+} // namespace
+
+TEST(mount_prober_test, responsive_mounts_report_their_space) {
+    fake_mount_t mount;
+    sbar::mount_prober_t mount_prober{ mount.probe() };
+
+    for (int refresh = 0; refresh < 3; ++refresh) {
+        auto space = mount_prober.get_space("/mnt/disk", 1s);
+        ASSERT_TRUE(space.has_value());
+        EXPECT_EQ(space->capacity, 1000);
+        EXPECT_EQ(space->available, 250);
+    }
+
+    EXPECT_EQ(*mount.probes, 3);
+}
+
+TEST(mount_prober_test, probe_errors_are_reported) {
+    sbar::mount_prober_t mount_prober{ [](const std::string& /*path*/,
+                                         sbar::mount_prober_t::space_t&) {
+        return ENOENT;
+    } };
+
+    EXPECT_TRUE(mount_prober.get_space("/mnt/missing", 1s).has_error());
+}
+
+TEST(mount_prober_test, unresponsive_mounts_are_skipped_until_they_recover) {
+    fake_mount_t mount;
+    sbar::mount_prober_t mount_prober{ mount.probe() };
+
+    mount.gate->set_open(false);
+
+    // The first probe times out and is left running.
+    EXPECT_TRUE(mount_prober.get_space("/mnt/nfs", 10ms).has_error());
+    EXPECT_EQ(*mount.probes, 1);
+
+    // The mount is skipped without starting another probe.
+    EXPECT_TRUE(mount_prober.get_space("/mnt/nfs", 10ms).has_error());
+    EXPECT_EQ(*mount.probes, 1);
+
+    // Other mounts are unaffected.
+    mount.gate->set_open(true);
+    EXPECT_TRUE(mount_prober.get_space("/mnt/disk", 1s).has_value());
+
+    // Once the late probe returns, the mount is probed again.
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    res::optional_t<sbar::mount_prober_t::space_t> space =
+      mount_prober.get_space("/mnt/nfs", 1s);
+    while (space.has_error() && std::chrono::steady_clock::now() < deadline) {
+        space = mount_prober.get_space("/mnt/nfs", 1s);
+    }
+    ASSERT_TRUE(space.has_value());
+    EXPECT_EQ(space->capacity, 1000);
+}
+
+TEST(mount_prober_test, unused_mounts_are_forgotten) {
+    fake_mount_t mount;
+    sbar::mount_prober_t mount_prober{ mount.probe() };
+
+    mount.gate->set_open(false);
+    EXPECT_TRUE(mount_prober.get_space("/mnt/usb", 10ms).has_error());
+    EXPECT_EQ(*mount.probes, 1);
+
+    // The mount was probed since the last call, so it is kept and skipped.
+    mount_prober.forget_unused();
+    EXPECT_TRUE(mount_prober.get_space("/mnt/usb", 10ms).has_error());
+    EXPECT_EQ(*mount.probes, 1);
+
+    // Without another probe in between, its blocked thread is detached and
+    // the next request starts a new prober.
+    mount_prober.forget_unused();
+    mount_prober.forget_unused();
+    mount.gate->set_open(true);
+    EXPECT_TRUE(mount_prober.get_space("/mnt/usb", 1s).has_value());
+    EXPECT_EQ(*mount.probes, 2);
+}
+
+TEST(mount_prober_test, destruction_does_not_wait_for_unresponsive_mounts) {
+    fake_mount_t mount;
+    mount.gate->set_open(false);
+
+    {
+        sbar::mount_prober_t mount_prober{ mount.probe() };
+        EXPECT_TRUE(mount_prober.get_space("/mnt/nfs", 10ms).has_error());
+    }
+
+    // Let the detached thread finish.
+    mount.gate->set_open(true);
+}
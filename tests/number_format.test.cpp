@@ -0,0 +1,122 @@
+// Standard includes
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/number_format.hpp"
+
+namespace {
+
+// The number of heap allocations made by this program.
+size_t allocations = 0;
+
+} // namespace
+
+namespace {
+
+void* allocate(size_t size) {
+    ++allocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+} // namespace
+
+// The scalar and array forms are replaced together so that every
+// allocation is released by its matching deallocation function.
+
+void* operator new(size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t /*size*/) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t /*size*/) noexcept {
+    std::free(memory);
+}
+
+TEST(number_format_test, integers_are_formatted) {
+    EXPECT_EQ(sbar::format_integer(0), "0");
+    EXPECT_EQ(sbar::format_integer(42), "42");
+    EXPECT_EQ(sbar::format_integer(-42), "-42");
+    EXPECT_EQ(sbar::format_integer(7, 2), "07");
+    EXPECT_EQ(sbar::format_integer(123, 2), "123");
+    EXPECT_EQ(sbar::format_integer(18446744073709551615ULL),
+      "18446744073709551615");
+}
+
+TEST(number_format_test, fixed_numbers_are_rounded) {
+    EXPECT_EQ(sbar::format_fixed(41.6, 0), "42");
+    EXPECT_EQ(sbar::format_fixed(0.125, 2), "0.12");
+    EXPECT_EQ(sbar::format_fixed(1.5, 2), "1.50");
+    EXPECT_EQ(sbar::format_fixed(-3.25, 1), "-3.2");
+}
+
+TEST(number_format_test, storage_sizes_have_units) {
+    EXPECT_EQ(sbar::format_storage_size(512), "512");
+    EXPECT_EQ(sbar::format_storage_size(1024), "1024");
+    EXPECT_EQ(sbar::format_storage_size(1536), "1K");
+    EXPECT_EQ(sbar::format_storage_size(1ULL << 30), "1024M");
+    EXPECT_EQ(sbar::format_storage_size((5ULL << 30) + 1), "5G");
+    EXPECT_EQ(sbar::format_storage_size(3ULL << 50), "3P");
+}
+
+TEST(number_format_test, formatting_does_not_allocate) {
+    std::string status;
+    status.reserve(256);
+
+    auto before = allocations;
+
+    for (int field = 0; field < 100; ++field) {
+        status.clear();
+        sbar::append_integer(status, field, 2);
+        status += ' ';
+        sbar::append_fixed(status, 1.25 * field, 2);
+        status += ' ';
+        sbar::append_storage_size(status, 1ULL << (field % 60));
+
+        // Short strings are stored within the string itself.
+        auto value = sbar::format_fixed(99.5, 0);
+        auto size = sbar::format_storage_size(123456789);
+        EXPECT_FALSE(value.empty());
+        EXPECT_FALSE(size.empty());
+    }
+
+    // The widest values that the status bar formats: a 64-bit counter, a
+    // battery reading with a precision of 6, and a negative integer.
+    status.clear();
+    sbar::append_integer(status, std::numeric_limits<uint64_t>::max());
+    status += ' ';
+    sbar::append_fixed(status, 123456789.123456, 6);
+    status += ' ';
+    sbar::append_fixed(status, -1e15, 6);
+    status += ' ';
+    sbar::append_integer(status, std::numeric_limits<int64_t>::min());
+    status += ' ';
+    sbar::append_storage_size(status, std::numeric_limits<uint64_t>::max());
+
+    EXPECT_EQ(allocations, before);
+    EXPECT_EQ(status,
+      "18446744073709551615 123456789.123456 -1000000000000000.000000 "
+      "-9223372036854775808 16383P");
+}
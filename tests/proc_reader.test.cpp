@@ -0,0 +1,108 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/proc_reader.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(proc_reader_test, proc_stat_is_parsed) {
+    sbar::proc_stat_t stat;
+    auto parse_result = sbar::parse_proc_stat(
+      "cpu  10 0 10 70 10 0 0 0 0 0\n"
+      "cpu0 5 0 5 30 10 0 0 0 0 0\n"
+      "cpu1 5 0 5 40 0 0 0 0 0 0\n"
+      "intr 1234 0 1 2 3\n"
+      "ctxt 5678\n"
+      "btime 1700000000\n"
+      "processes 100\n"
+      "procs_running 3\n"
+      "procs_blocked 0\n",
+      stat);
+    ASSERT_TRUE(parse_result.success());
+
+    EXPECT_EQ(stat.cpu.busy, 20);
+    EXPECT_EQ(stat.cpu.total, 100);
+    ASSERT_EQ(stat.cores.size(), 2);
+    EXPECT_EQ(stat.cores.at(0).busy, 10);
+    EXPECT_EQ(stat.cores.at(0).total, 50);
+    EXPECT_EQ(stat.interrupts, 1234);
+    EXPECT_EQ(stat.context_switches, 5678);
+    EXPECT_EQ(stat.procs_running, 3);
+}
+
+TEST(proc_reader_test, meminfo_is_parsed) {
+    auto meminfo = sbar::parse_meminfo("MemTotal:       16000000 kB\n"
+                                       "MemFree:         1000000 kB\n"
+                                       "MemAvailable:    8000000 kB\n"
+                                       "Cached:          4000000 kB\n"
+                                       "SwapTotal:       2000000 kB\n"
+                                       "SwapFree:        1500000 kB\n"
+                                       "Dirty:               512 kB\n");
+    ASSERT_TRUE(meminfo.has_value());
+
+    EXPECT_EQ(meminfo->total, 16000000);
+    EXPECT_EQ(meminfo->available, 8000000);
+    EXPECT_EQ(meminfo->cached, 4000000);
+    EXPECT_EQ(meminfo->dirty, 512);
+    EXPECT_EQ(meminfo->swap_total, 2000000);
+    EXPECT_EQ(meminfo->swap_free, 1500000);
+
+    EXPECT_TRUE(sbar::parse_meminfo("MemFree: 1 kB\n").has_error());
+}
+
+TEST(proc_reader_test, loadavg_is_parsed) {
+    auto loadavg = sbar::parse_loadavg("0.25 1.50 12.05 2/345 6789\n");
+    ASSERT_TRUE(loadavg.has_value());
+
+    EXPECT_DOUBLE_EQ(loadavg->load_1, 0.25);
+    EXPECT_DOUBLE_EQ(loadavg->load_5, 1.5);
+    EXPECT_DOUBLE_EQ(loadavg->load_15, 12.05);
+
+    EXPECT_TRUE(sbar::parse_loadavg("").has_error());
+}
+
+TEST(proc_reader_test, usage_and_rates_are_computed_between_samples) {
+    sbar::cpu_usage_t cpu_usage;
+    auto start = sbar::cpu_usage_t::clock_t::now();
+
+    EXPECT_TRUE(cpu_usage.get_total().has_error());
+
+    ASSERT_TRUE(cpu_usage
+                  .update("cpu  10 0 10 80 0 0 0 0\n"
+                          "cpu0 10 0 10 80 0 0 0 0\n"
+                          "intr 100\nctxt 1000\nprocs_running 2\n",
+                    start)
+                  .success());
+    ASSERT_TRUE(cpu_usage.get_total().has_value());
+    EXPECT_DOUBLE_EQ(cpu_usage.get_total().value(), 20);
+    EXPECT_DOUBLE_EQ(cpu_usage.get_context_switch_rate(), 0);
+
+    ASSERT_TRUE(cpu_usage
+                  .update("cpu  60 0 10 130 0 0 0 0\n"
+                          "cpu0 60 0 10 130 0 0 0 0\n"
+                          "intr 300\nctxt 2000\nprocs_running 4\n",
+                    start + 500ms)
+                  .success());
+    EXPECT_DOUBLE_EQ(cpu_usage.get_total().value(), 50);
+    ASSERT_EQ(cpu_usage.get_per_core().size(), 1);
+    EXPECT_DOUBLE_EQ(cpu_usage.get_per_core().at(0), 50);
+    EXPECT_DOUBLE_EQ(cpu_usage.get_interrupt_rate(), 400);
+    EXPECT_DOUBLE_EQ(cpu_usage.get_context_switch_rate(), 2000);
+    EXPECT_EQ(cpu_usage.get_procs_running(), 4);
+}
+
+TEST(proc_reader_test, proc_files_are_read_whole) {
+    // Start with a buffer that is too small to hold the file.
+    sbar::proc_file_t proc_stat{ "/proc/stat", 16 };
+
+    for (int read = 0; read < 2; ++read) {
+        auto contents = proc_stat.read();
+        ASSERT_TRUE(contents.has_value());
+
+        sbar::proc_stat_t stat;
+        EXPECT_TRUE(sbar::parse_proc_stat(contents.value(), stat).success());
+        EXPECT_GT(stat.cpu.total, 0);
+        EXPECT_GT(stat.context_switches, 0);
+    }
+}
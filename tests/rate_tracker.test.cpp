@@ -0,0 +1,59 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/rate_tracker.hpp"
+
+using namespace std::chrono_literals;
+
+using rate_tracker_t = sbar::rate_tracker_t<2>;
+
+TEST(rate_tracker_test, rates_need_two_samples) {
+    rate_tracker_t rate_tracker;
+    auto start = rate_tracker_t::clock_t::now();
+
+    EXPECT_FALSE(rate_tracker.get_rates("eth0").has_value());
+    rate_tracker.sample("eth0", { 100, 10 }, start);
+    EXPECT_FALSE(rate_tracker.get_rates("eth0").has_value());
+}
+
+TEST(rate_tracker_test, rates_are_per_second_of_elapsed_time) {
+    rate_tracker_t rate_tracker;
+    auto start = rate_tracker_t::clock_t::now();
+
+    rate_tracker.sample("eth0", { 100, 10 }, start);
+    rate_tracker.sample("eth0", { 1100, 510 }, start + 500ms);
+
+    auto rates = rate_tracker.get_rates("eth0");
+    ASSERT_TRUE(rates.has_value());
+    EXPECT_DOUBLE_EQ(rates->at(0), 2000);
+    EXPECT_DOUBLE_EQ(rates->at(1), 1000);
+}
+
+TEST(rate_tracker_test, decreasing_counters_have_no_rate) {
+    rate_tracker_t rate_tracker;
+    auto start = rate_tracker_t::clock_t::now();
+
+    rate_tracker.sample("eth0", { 1000, 10 }, start);
+    rate_tracker.sample("eth0", { 50, 20 }, start + 1s);
+
+    auto rates = rate_tracker.get_rates("eth0");
+    ASSERT_TRUE(rates.has_value());
+    EXPECT_DOUBLE_EQ(rates->at(0), 0);
+    EXPECT_DOUBLE_EQ(rates->at(1), 10);
+}
+
+TEST(rate_tracker_test, devices_not_sampled_recently_are_forgotten) {
+    rate_tracker_t rate_tracker;
+    auto start = rate_tracker_t::clock_t::now();
+
+    rate_tracker.sample("eth0", { 0, 0 }, start);
+    rate_tracker.sample("wlan0", { 0, 0 }, start);
+    rate_tracker.sample("eth0", { 10, 10 }, start + 1s);
+    rate_tracker.sample("wlan0", { 10, 10 }, start + 1s);
+    rate_tracker.sample("eth0", { 20, 20 }, start + 2s);
+
+    rate_tracker.forget_before(start + 2s);
+    EXPECT_TRUE(rate_tracker.get_rates("eth0").has_value());
+    EXPECT_FALSE(rate_tracker.get_rates("wlan0").has_value());
+}
@@ -0,0 +1,61 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/scheduler.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(scheduler_test, fields_are_due_immediately) {
+    sbar::scheduler_t scheduler;
+    scheduler.add(sbar_field_time, 1000ms);
+    scheduler.add(sbar_field_kernel, sbar::scheduler_t::once);
+
+    auto now = sbar::scheduler_t::clock_t::now();
+    EXPECT_EQ(scheduler.pop_due(now), sbar_field_time | sbar_field_kernel);
+    EXPECT_EQ(scheduler.pop_due(now), sbar_field_none);
+}
+
+TEST(scheduler_test, fields_generated_once_are_not_rescheduled) {
+    sbar::scheduler_t scheduler;
+    scheduler.add(sbar_field_kernel, sbar::scheduler_t::once);
+
+    auto now = sbar::scheduler_t::clock_t::now();
+    EXPECT_EQ(scheduler.pop_due(now), sbar_field_kernel);
+    EXPECT_FALSE(scheduler.next_deadline().has_value());
+}
+
+TEST(scheduler_test, fields_are_due_at_their_own_interval) {
+    sbar::scheduler_t scheduler;
+    scheduler.add(sbar_field_time, 1000ms);
+    scheduler.add(sbar_field_uptime, 1000ms);
+    scheduler.add(sbar_field_disk, 5000ms);
+
+    auto start = sbar::scheduler_t::clock_t::now();
+    EXPECT_EQ(scheduler.pop_due(start),
+      sbar_field_time | sbar_field_uptime | sbar_field_disk);
+
+    auto next_deadline = scheduler.next_deadline();
+    ASSERT_TRUE(next_deadline.has_value());
+    EXPECT_LE(next_deadline.value() - start, 1000ms);
+
+    EXPECT_EQ(scheduler.pop_due(start + 1000ms),
+      sbar_field_time | sbar_field_uptime);
+    EXPECT_EQ(scheduler.pop_due(start + 5000ms),
+      sbar_field_time | sbar_field_uptime | sbar_field_disk);
+}
+
+TEST(scheduler_test, missed_refreshes_are_not_replayed) {
+    sbar::scheduler_t scheduler;
+    scheduler.add(sbar_field_time, 1000ms);
+
+    auto start = sbar::scheduler_t::clock_t::now();
+    EXPECT_EQ(scheduler.pop_due(start), sbar_field_time);
+    EXPECT_EQ(scheduler.pop_due(start + 10500ms), sbar_field_time);
+    EXPECT_EQ(scheduler.pop_due(start + 10500ms), sbar_field_none);
+
+    auto next_deadline = scheduler.next_deadline();
+    ASSERT_TRUE(next_deadline.has_value());
+    EXPECT_GT(next_deadline.value(), start + 10500ms);
+    EXPECT_LE(next_deadline.value(), start + 11500ms);
+}
@@ -0,0 +1,55 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/status_buffer.hpp"
+
+sbar_field_t test_field_assigner(char token) {
+    switch (token) {
+        case 'T':
+            return sbar_field_time;
+        case 'U':
+            return sbar_field_uptime;
+        default:
+            return sbar_field_none;
+    }
+}
+
+const size_t time_index = __builtin_ctzll(sbar_field_time);
+const size_t uptime_index = __builtin_ctzll(sbar_field_uptime);
+
+TEST(status_buffer_test, literals_are_written_once) {
+    auto format = sbar::compile_format("[/T] (/U)", test_field_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    sbar::status_buffer_t status{ format.value() };
+    EXPECT_EQ(status.str(), "[] ()");
+}
+
+TEST(status_buffer_test, slots_are_patched_in_place) {
+    auto format = sbar::compile_format("[/T] (/U) /T", test_field_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    sbar::status_buffer_t status{ format.value() };
+    EXPECT_TRUE(status.set(time_index, "12:00"));
+    EXPECT_TRUE(status.set(uptime_index, "1d"));
+    EXPECT_EQ(status.str(), "[12:00] (1d) 12:00");
+
+    EXPECT_TRUE(status.set(time_index, "9:5"));
+    EXPECT_EQ(status.str(), "[9:5] (1d) 9:5");
+    EXPECT_EQ(status.get(uptime_index), "1d");
+
+    EXPECT_TRUE(status.set(uptime_index, "10d"));
+    EXPECT_EQ(status.str(), "[9:5] (10d) 9:5");
+}
+
+TEST(status_buffer_test, unchanged_value_is_not_reported) {
+    auto format = sbar::compile_format("/T", test_field_assigner);
+    ASSERT_TRUE(format.has_value());
+
+    sbar::status_buffer_t status{ format.value() };
+    EXPECT_TRUE(status.set(time_index, "12:00"));
+    EXPECT_FALSE(status.set(time_index, "12:00"));
+    EXPECT_FALSE(status.set(uptime_index, "1d"));
+    EXPECT_EQ(status.get(uptime_index), "");
+}
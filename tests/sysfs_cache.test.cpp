@@ -0,0 +1,104 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+
+// External includes
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+// Local includes
+#include "../src/sysfs_cache.hpp"
+
+namespace {
+
+class sysfs_cache_test : public testing::Test {
+  protected:
+    std::filesystem::path directory_;
+
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path()
+          / ("sysfs_cache_test_" + std::to_string(getpid()));
+        std::filesystem::create_directories(directory_ / "device");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    void write(const std::filesystem::path& path, const std::string& value) {
+        // Truncating keeps the file, so open descriptors see the new value.
+        std::ofstream{ path } << value;
+    }
+};
+
+} // namespace
+
+TEST_F(sysfs_cache_test, attributes_are_read_without_newlines) {
+    write(directory_ / "device" / "status", "Discharging\n");
+
+    sbar::sysfs_cache_t sysfs_cache;
+    std::string status;
+    ASSERT_TRUE(
+      sysfs_cache.read(directory_ / "device" / "status", status).success());
+    EXPECT_EQ(status, "Discharging");
+}
+
+TEST_F(sysfs_cache_test, attributes_replace_the_contents_of_the_buffer) {
+    write(directory_ / "device" / "status", "Not charging\n");
+    write(directory_ / "device" / "online", "1\n");
+
+    sbar::sysfs_cache_t sysfs_cache;
+    std::string contents;
+    ASSERT_TRUE(
+      sysfs_cache.read(directory_ / "device" / "status", contents).success());
+    EXPECT_EQ(contents, "Not charging");
+
+    ASSERT_TRUE(
+      sysfs_cache.read(directory_ / "device" / "online", contents).success());
+    EXPECT_EQ(contents, "1");
+
+    EXPECT_TRUE(
+      sysfs_cache.read(directory_ / "device" / "missing", contents).failure());
+    EXPECT_TRUE(contents.empty());
+}
+
+TEST_F(sysfs_cache_test, attributes_are_reread_from_the_start) {
+    write(directory_ / "device" / "temp", "41000\n");
+
+    sbar::sysfs_cache_t sysfs_cache;
+    auto temperature = sysfs_cache.read_integer(directory_ / "device" / "temp");
+    ASSERT_TRUE(temperature.has_value());
+    EXPECT_EQ(temperature.value(), 41000);
+
+    write(directory_ / "device" / "temp", "52000\n");
+    temperature = sysfs_cache.read_integer(directory_ / "device" / "temp");
+    ASSERT_TRUE(temperature.has_value());
+    EXPECT_EQ(temperature.value(), 52000);
+}
+
+TEST_F(sysfs_cache_test, invalid_integers_are_errors) {
+    write(directory_ / "device" / "temp", "hot\n");
+
+    sbar::sysfs_cache_t sysfs_cache;
+    EXPECT_TRUE(
+      sysfs_cache.read_integer(directory_ / "device" / "temp").has_error());
+    EXPECT_TRUE(
+      sysfs_cache.read_integer(directory_ / "device" / "missing").has_error());
+}
+
+TEST_F(sysfs_cache_test, invalidated_attributes_are_reopened) {
+    write(directory_ / "device" / "capacity", "80\n");
+
+    sbar::sysfs_cache_t sysfs_cache;
+    ASSERT_EQ(
+      sysfs_cache.read_integer(directory_ / "device" / "capacity").value(), 80);
+
+    // Replace the device. The open descriptor refers to the removed file.
+    std::filesystem::remove_all(directory_ / "device");
+    std::filesystem::create_directories(directory_ / "device");
+    write(directory_ / "device" / "capacity", "30\n");
+
+    sysfs_cache.invalidate(directory_);
+    EXPECT_EQ(
+      sysfs_cache.read_integer(directory_ / "device" / "capacity").value(), 30);
+}
@@ -0,0 +1,44 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/value_filter.hpp"
+
+TEST(value_filter_test, unconfigured_filter_publishes_every_value) {
+    sbar::value_filter_t filter;
+
+    EXPECT_DOUBLE_EQ(filter.apply(41.3), 41.3);
+    EXPECT_DOUBLE_EQ(filter.apply(41.7), 41.7);
+}
+
+TEST(value_filter_test, values_are_rounded_to_the_quantum) {
+    sbar::value_filter_t filter;
+    filter.set_quantum(2);
+
+    EXPECT_DOUBLE_EQ(filter.apply(40.9), 40);
+    EXPECT_DOUBLE_EQ(filter.apply(41.1), 42);
+    EXPECT_DOUBLE_EQ(filter.apply(-3.2), -4);
+}
+
+TEST(value_filter_test, small_changes_are_held_back) {
+    sbar::value_filter_t filter;
+    filter.set_hysteresis(3);
+
+    EXPECT_DOUBLE_EQ(filter.apply(50), 50);
+    EXPECT_DOUBLE_EQ(filter.apply(52.9), 50);
+    EXPECT_DOUBLE_EQ(filter.apply(47.1), 50);
+    EXPECT_DOUBLE_EQ(filter.apply(53), 53);
+    EXPECT_DOUBLE_EQ(filter.apply(51), 53);
+}
+
+TEST(value_filter_test, devices_are_tracked_separately) {
+    sbar::value_filter_t filter;
+    filter.set_quantum(2);
+    filter.set_hysteresis(3);
+
+    EXPECT_DOUBLE_EQ(filter.apply(41.2, "eth0"), 42);
+    EXPECT_DOUBLE_EQ(filter.apply(10, "wlan0"), 10);
+    EXPECT_DOUBLE_EQ(filter.apply(43.9, "eth0"), 42);
+    EXPECT_DOUBLE_EQ(filter.apply(11, "wlan0"), 10);
+    EXPECT_DOUBLE_EQ(filter.apply(44.5, "eth0"), 44);
+}
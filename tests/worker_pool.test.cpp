@@ -0,0 +1,122 @@
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+#include <poll.h>
+
+// Local includes
+#include "../src/worker_pool.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+void wait_for_completions(const sbar::worker_pool_t& worker_pool) {
+    pollfd descriptor{ worker_pool.fd(), POLLIN, 0 };
+    ASSERT_EQ(poll(&descriptor, 1, 1000), 1);
+}
+
+} // namespace
+
+TEST(worker_pool_test, completions_run_on_the_owning_thread) {
+    auto worker_pool = sbar::get_worker_pool(2);
+    ASSERT_TRUE(worker_pool.has_value());
+
+    std::thread::id job_thread;
+    std::thread::id completion_thread;
+
+    worker_pool->submit([&]() -> sbar::worker_pool_t::completion_t {
+        job_thread = std::this_thread::get_id();
+        return [&]() { completion_thread = std::this_thread::get_id(); };
+    });
+
+    wait_for_completions(worker_pool.value());
+    worker_pool->run_completions();
+
+    EXPECT_NE(job_thread, std::this_thread::get_id());
+    EXPECT_EQ(completion_thread, std::this_thread::get_id());
+}
+
+TEST(worker_pool_test, every_job_completes) {
+    auto worker_pool = sbar::get_worker_pool(4);
+    ASSERT_TRUE(worker_pool.has_value());
+
+    const int total_jobs = 64;
+    std::vector<int> results;
+
+    for (int job = 0; job < total_jobs; ++job) {
+        worker_pool->submit([&results, job]() {
+            return [&results, job]() { results.push_back(job); };
+        });
+    }
+
+    while (results.size() < total_jobs) {
+        wait_for_completions(worker_pool.value());
+        worker_pool->run_completions();
+    }
+
+    EXPECT_EQ(results.size(), total_jobs);
+}
+
+TEST(worker_pool_test, stop_waits_for_running_jobs) {
+    auto worker_pool = sbar::get_worker_pool(1);
+    ASSERT_TRUE(worker_pool.has_value());
+
+    std::promise<void> started;
+    std::atomic<bool> finished = false;
+
+    worker_pool->submit([&]() {
+        started.set_value();
+        std::this_thread::sleep_for(10ms);
+        finished = true;
+        return sbar::worker_pool_t::completion_t{};
+    });
+
+    started.get_future().wait();
+    EXPECT_TRUE(worker_pool->stop(1s));
+    EXPECT_TRUE(finished);
+}
+
+TEST(worker_pool_test, stop_drops_queued_jobs_and_leaves_blocked_jobs) {
+    std::promise<void> started;
+    std::promise<void> release;
+    std::promise<void> finished;
+    std::atomic<int> finished_jobs = 0;
+
+    {
+        auto worker_pool = sbar::get_worker_pool(1);
+        ASSERT_TRUE(worker_pool.has_value());
+
+        // Blocks like a read from a device that stopped responding.
+        worker_pool->submit([&]() {
+            started.set_value();
+            release.get_future().wait();
+            ++finished_jobs;
+            finished.set_value();
+            return sbar::worker_pool_t::completion_t{};
+        });
+        started.get_future().wait();
+
+        for (int job = 0; job < 8; ++job) {
+            worker_pool->submit([&finished_jobs]() {
+                ++finished_jobs;
+                return sbar::worker_pool_t::completion_t{};
+            });
+        }
+
+        EXPECT_FALSE(worker_pool->stop(10ms));
+    }
+
+    // The detached worker finishes its job once it is unblocked but does not
+    // run the dropped ones.
+    release.set_value();
+    finished.get_future().wait();
+    std::this_thread::sleep_for(10ms);
+
+    EXPECT_EQ(finished_jobs, 1);
+}